@@ -1,695 +1,6168 @@
 #include <iostream>
+#include <string>
 #include <stdexcept>
 #include <cmath>
+#include <climits>
+#include <limits>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <iterator>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <charconv>
+#if defined(__has_include)
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define PYLIST_POSIX_MMAP 1
+#endif
+#endif
 
-template<typename Type>
-class pyList{
-    const int INITIAL_ARRAY_SIZE = 100;
-    const float RESIZE_FACTOR = 2;
+class pyArena{
+    struct Block{
+        Block *next;
+        size_t size;
+    };
 
-    long Head;
-    long Tail;
-    size_t allocated;
-    long length;
-    Type *Array;
+    size_t initial_size;
+    size_t block_size;
+    Block *blocks;
+    char *cursor;
+    char *limit;
 
-    pyList(const size_t);
-    void _swap(pyList<Type> &);
-    inline long _next_index(const long index) const { return (index + 1) % allocated; }
-    inline long _prev_index(const long index) const { return (index + allocated - 1) % allocated; }
-    inline long _transform_index(const long) const;
-    inline long _untransform_index(const long) const;
-    long _clamp(const long, const long, const long) const;
-    long _len_between(const long , const long) const;
-    long _partition(const long, const long);
-    void _quicksort(const long, const long);
-    void _testsort() const;
-    bool _is_valid_index(const long) const;
-    void _resize_if_necessary();
+    void _add_block(const size_t, const size_t);
+    static void _free_blocks(Block *);
 
 public:
-    pyList();
-    pyList(const pyList<Type> & );
-    pyList(const std::initializer_list<Type>);
-    pyList(pyList<Type> && );
-    ~pyList();
-    pyList<Type> & operator = (pyList<Type>);
-    Type & operator [] (const long);
-    const Type operator [] (const long) const;
-    pyList<Type> operator () (const long, const long, const long) const;
-    pyList<Type> operator + (const pyList<Type> &) const;
-    void operator += (const pyList<Type> &);
-    pyList<Type> operator * (const long) const;
-    void operator *= (const long);
-    bool operator == (const pyList<Type> &) const;
-    bool operator != (const pyList<Type> &) const;
-    bool operator < (const pyList<Type> &) const;
-    bool operator >= (const pyList<Type> &) const;
-    bool operator <= (const pyList<Type> &) const;
-    bool operator > (const pyList<Type> &) const;
-    inline long len() const;
-    void reverse();
-    Type get(const long) const;
-    void set(const long, const Type);
-    void append(const Type);
-    void extend(const pyList<Type> &);
-    pyList<Type> slice(const long, const long, const long) const;
-    Type pop(const long);
-    void remove(const Type);
-    void clear();
-    long count(const Type) const;
-    long index(const Type, const long, const long);
-    Type max();
-    Type min();
-    Type sum();
-    void insert(const long, const Type);
-    void sort();
+    explicit pyArena(const size_t = 64*1024);
+    pyArena(const pyArena &) = delete;
+    pyArena & operator = (const pyArena &) = delete;
+    ~pyArena();
+    void * allocate(const size_t, const size_t);
+    void release();
 };
 
-template<typename Type>
-pyList<Type>::pyList(){
-    Head = 0;
-    Tail = 0;
-    length = 0;
-    allocated = INITIAL_ARRAY_SIZE;
-    Array = new Type[allocated];
+pyArena::pyArena(const size_t initial_block_size){
+    initial_size = initial_block_size;
+    block_size = initial_block_size;
+    blocks = nullptr;
+    cursor = nullptr;
+    limit = nullptr;
 }
 
-template<typename Type>
-pyList<Type>::pyList(const size_t request_size){
-    Head = 0;
-    Tail = 0;
-    length = 0;
-    allocated = request_size>INITIAL_ARRAY_SIZE?request_size:INITIAL_ARRAY_SIZE;
-    Array = new Type[allocated];
+pyArena::~pyArena(){
+    _free_blocks(blocks);
 }
 
-template<typename Type>
-pyList<Type>::pyList(const pyList<Type> & rhs){
-    Head = 0;
-    Tail = rhs.length;
-    length = rhs.length;
-    allocated = rhs.allocated;
-    Array = new Type[allocated];
-    for(unsigned long i=1; i<=Tail; i++){
-        Array[i] = rhs[i-1];
+void pyArena::_free_blocks(Block * block){
+    while(block != nullptr){
+        Block *next = block->next;
+        ::operator delete(block);
+        block = next;
     }
 }
 
-/*template<typename Type>
-pyList<Type>::pyList(const std::initializer_list<Type> source):pyList(RESIZE_FACTOR*source.size()){
-    std::cout << "init_list " << source.size() << " " << RESIZE_FACTOR*source.size() << std::endl;
-    for(Type item:source){
-        Array[++Tail] = item;
+void pyArena::_add_block(const size_t bytes, const size_t alignment){
+    size_t required = sizeof(Block) + bytes + alignment;
+    while(block_size < required){
+        block_size *= 2;
     }
-    length = source.size();
-}*/
-
-template<typename Type>
-pyList<Type>::pyList(const std::initializer_list<Type> source){
-    Head = 0;
-    Tail = 0;
-    int required_size = RESIZE_FACTOR*source.size();
-    allocated = required_size>INITIAL_ARRAY_SIZE?required_size:INITIAL_ARRAY_SIZE;
-    Array = new Type[allocated];
+    Block *block = static_cast<Block *>(::operator new(block_size));
+    block->next = blocks;
+    block->size = block_size;
+    blocks = block;
+    cursor = reinterpret_cast<char *>(block + 1);
+    limit = reinterpret_cast<char *>(block) + block_size;
+    block_size *= 2;
+}
 
-    for(Type item:source){
-        Array[++Tail] = item;
+void * pyArena::allocate(const size_t bytes, const size_t alignment){
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if(cursor == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(limit)){
+        _add_block(bytes, alignment);
+        aligned = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t)(alignment - 1);
     }
-    length = source.size();
+    cursor = reinterpret_cast<char *>(aligned + bytes);
+    return reinterpret_cast<void *>(aligned);
 }
 
-template<typename Type>
-pyList<Type>::pyList(pyList<Type> && rhs){
-    Head = rhs.Head;
-    Tail = rhs.Tail;
-    length = rhs.length;
-    allocated = rhs.allocated;
-    Array = rhs.Array;
-    rhs.Array = nullptr;
+void pyArena::release(){
+    if(blocks == nullptr){
+        block_size = initial_size;
+        return;
+    }
+    _free_blocks(blocks->next);
+    blocks->next = nullptr;
+    block_size = std::max(initial_size, blocks->size);
+    cursor = reinterpret_cast<char *>(blocks + 1);
+    limit = reinterpret_cast<char *>(blocks) + blocks->size;
 }
 
-template<typename Type>
-pyList<Type>::~pyList(){
-    delete[] Array;
-}
+class pyPool{
+    static const int MIN_CLASS_SHIFT = 4;
+    static const int NUM_CLASSES = 16;
+    static const size_t MAX_CLASS_ALIGNMENT = 64;
 
-template<typename Type>
-void pyList<Type>::_swap(pyList<Type> & List){
-    std::swap(Head, List.Head);
-    std::swap(Tail, List.Tail);
-    std::swap(length, List.length);
-    std::swap(allocated, List.allocated);
-    std::swap(Array, List.Array);
-}
+    struct FreeNode{
+        FreeNode *next;
+    };
 
-template<typename Type>
-pyList<Type> & pyList<Type>::operator = (pyList<Type> rhs){
-    this->_swap(rhs);
-    return *this;
-}
+    FreeNode *free_lists[NUM_CLASSES];
+    pyArena arena;
 
-template<typename Type>
-Type & pyList<Type>::operator [] (const long index){
-    long act_index = _transform_index(index);
-    return Array[act_index];
-}
+    static int _size_class(const size_t);
 
-template<typename Type>
-const Type pyList<Type>::operator [] (const long index) const {
-    long act_index = _transform_index(index);
-    return Array[act_index];
-}
+public:
+    pyPool();
+    pyPool(const pyPool &) = delete;
+    pyPool & operator = (const pyPool &) = delete;
+    void * allocate(const size_t, const size_t);
+    void deallocate(void *, const size_t, const size_t);
+};
 
-template<typename Type>
-pyList<Type> pyList<Type>::operator () (const long start = 0, const long stop = LONG_MAX, const long step = 1) const {
-    if(step == 0){
-        throw std::invalid_argument("step cannot be zero");
-    }
-    long stop_clamped = _clamp(stop,-length-1,length);
-    stop_clamped = stop_clamped>=0? stop_clamped:stop_clamped + length;
-    long start_clamped = _clamp(start,-length, length-1);
-    start_clamped = start_clamped>=0? start_clamped: start_clamped + length;
-    pyList newList((std::abs(stop_clamped - start_clamped/step)+1)*2);
-    newList.Head = 0;
-    long ctr = 0;
-    long step_sgn = step/std::abs(step);
-    for(long i = start_clamped; step_sgn*i < step_sgn*stop_clamped ; i += step){
-        newList.Array[++ctr] = Array[_transform_index(i)];
+pyPool::pyPool(){
+    for(int i=0; i<NUM_CLASSES; i++){
+        free_lists[i] = nullptr;
     }
-    newList.Tail = ctr;
-    newList.length = ctr;
-    return newList;
 }
 
-template<typename Type>
-bool pyList<Type>::operator == (const pyList<Type> & rhs) const {
-    if(length != rhs.length){ return false; }
-    if(this != &rhs){
-        for(unsigned long i=0; i<length; i++){
-            if((*this)[i] != rhs[i]){ return false; }
-        }
+int pyPool::_size_class(const size_t bytes){
+    int k = 0;
+    while(((size_t)1 << (k + MIN_CLASS_SHIFT)) < bytes){
+        ++k;
     }
-    return true;
-}
-
-template<typename Type>
-bool pyList<Type>::operator != (const pyList<Type> & rhs) const {
-    return !((*this) == rhs);
+    return k;
 }
 
-template<typename Type>
-bool pyList<Type>::operator < (const pyList<Type> & rhs) const {
-    long min_len = length < rhs.length ? length : rhs.length;
-    for(unsigned long i=0; i<min_len; ++i){
-        if((*this)[i] > rhs[i]){
-            return false;
-        }
-        else if((*this)[i] < rhs[i]){
-            return true;
-        }
+void * pyPool::allocate(const size_t bytes, const size_t alignment){
+    int k = _size_class(bytes);
+    if(k >= NUM_CLASSES || alignment > MAX_CLASS_ALIGNMENT){
+        return ::operator new(bytes, std::align_val_t(alignment));
     }
-    if(length < rhs.length){
-        return true;
+    if(free_lists[k] != nullptr){
+        FreeNode *node = free_lists[k];
+        free_lists[k] = node->next;
+        return node;
     }
-    return false;
+    size_t class_size = (size_t)1 << (k + MIN_CLASS_SHIFT);
+    return arena.allocate(class_size, class_size < MAX_CLASS_ALIGNMENT ? class_size : MAX_CLASS_ALIGNMENT);
 }
 
-template<typename Type>
-bool pyList<Type>::operator >= (const pyList<Type> & rhs) const {
-    return !((*this) < rhs);
+void pyPool::deallocate(void * pointer, const size_t bytes, const size_t alignment){
+    int k = _size_class(bytes);
+    if(k >= NUM_CLASSES || alignment > MAX_CLASS_ALIGNMENT){
+        ::operator delete(pointer, std::align_val_t(alignment));
+        return;
+    }
+    FreeNode *node = static_cast<FreeNode *>(pointer);
+    node->next = free_lists[k];
+    free_lists[k] = node;
 }
 
 template<typename Type>
-bool pyList<Type>::operator <= (const pyList<Type> & rhs) const {
-    return !((*this) > rhs);
-}
+class pyArenaAllocator{
+    template<typename> friend class pyArenaAllocator;
+    pyArena *arena;
 
-template<typename Type>
-bool pyList<Type>::operator > (const pyList<Type> & rhs) const {
-    return (rhs < (*this));
-}
+public:
+    typedef Type value_type;
 
-template<typename Type>
-pyList<Type> pyList<Type>::operator + (const pyList<Type> & rhs) const {
-    pyList<Type> temp = *this;
-    temp.extend(rhs);
-    return temp;
-}
+    pyArenaAllocator(pyArena & source) : arena(&source) {}
+    template<typename Other>
+    pyArenaAllocator(const pyArenaAllocator<Other> & rhs) : arena(rhs.arena) {}
+    Type * allocate(const size_t n){ return static_cast<Type *>(arena->allocate(n * sizeof(Type), alignof(Type))); }
+    void deallocate(Type *, const size_t){}
+    template<typename Other>
+    bool operator == (const pyArenaAllocator<Other> & rhs) const { return arena == rhs.arena; }
+    template<typename Other>
+    bool operator != (const pyArenaAllocator<Other> & rhs) const { return arena != rhs.arena; }
+};
 
 template<typename Type>
-void pyList<Type>::operator += (const pyList<Type> & rhs){
-    this->extend(rhs);
-}
+class pyPoolAllocator{
+    template<typename> friend class pyPoolAllocator;
+    pyPool *pool;
 
-template<typename Type>
-pyList<Type> pyList<Type>::operator * (const long rhs) const {
-    pyList<Type> temp;
-    for(long i=0; i<rhs; i++){
-        temp.extend(*this);
-    }
-    return temp;
-}
+public:
+    typedef Type value_type;
+
+    pyPoolAllocator(pyPool & source) : pool(&source) {}
+    template<typename Other>
+    pyPoolAllocator(const pyPoolAllocator<Other> & rhs) : pool(rhs.pool) {}
+    Type * allocate(const size_t n){ return static_cast<Type *>(pool->allocate(n * sizeof(Type), alignof(Type))); }
+    void deallocate(Type * pointer, const size_t n){ pool->deallocate(pointer, n * sizeof(Type), alignof(Type)); }
+    template<typename Other>
+    bool operator == (const pyPoolAllocator<Other> & rhs) const { return pool == rhs.pool; }
+    template<typename Other>
+    bool operator != (const pyPoolAllocator<Other> & rhs) const { return pool != rhs.pool; }
+};
 
 template<typename Type>
-void pyList<Type>::operator *= (const long rhs){
-    pyList<Type> temp;
-    if(rhs <= 0){
-        *this = temp;
-    }
-    temp = *this;
-    for(long i=1; i<rhs; i++){
-        this->extend(temp);
-    }
-}
+struct pyLess{
+    bool operator () (const Type & a, const Type & b) const { return a < b; }
+};
 
 template<typename Type>
-const pyList<Type> operator * (const long lhs, pyList<Type> & rhs){
-    return (rhs*lhs);
+struct pyGreater{
+    bool operator () (const Type & a, const Type & b) const { return b < a; }
+};
+
+template<typename Item, typename Compare>
+class pyTimSort{
+    static const long MIN_MERGE = 32;
+    static const long MIN_GALLOP = 7;
+    static const int MAX_RUNS = 85;
+
+    Item *Array;
+    Compare comp;
+    long min_gallop;
+    Item *temp;
+    long temp_size;
+    long temp_live;
+    long run_base[MAX_RUNS];
+    long run_len[MAX_RUNS];
+    int stack_size;
+
+    pyTimSort(Item *, Compare);
+    ~pyTimSort();
+    static long _min_run_length(long);
+    long _count_run_and_make_ascending(const long, const long);
+    void _binary_sort(const long, const long, long);
+    long _gallop_left(const Item &, const Item *, const long, const long);
+    long _gallop_right(const Item &, const Item *, const long, const long);
+    Item * _fill_temp(Item *, const long);
+    void _release_temp();
+    void _merge_collapse();
+    void _merge_force_collapse();
+    void _merge_at(const int);
+    void _merge_lo(long, long, long, long);
+    void _merge_hi(long, long, long, long);
+
+public:
+    static void sort(Item *, const long, Compare);
+};
+
+template<typename Item, typename Compare>
+pyTimSort<Item, Compare>::pyTimSort(Item * source, Compare compare):comp(compare){
+    Array = source;
+    min_gallop = MIN_GALLOP;
+    temp = nullptr;
+    temp_size = 0;
+    temp_live = 0;
+    stack_size = 0;
 }
 
-template<typename Type>
-std::ostream & operator << (std::ostream & o, const pyList<Type> & List){
-    o << "[";
-    int flag = 0;
-    long n = List.len();
-    for(long i=0; i < n; i++){
-        if(flag == 0){ o << List[i] ; ++flag;}
-        else{ o << ", " << List[i]; }
-    }
-    return o << "]";
+template<typename Item, typename Compare>
+pyTimSort<Item, Compare>::~pyTimSort(){
+    _release_temp();
+    std::allocator<Item>().deallocate(temp, temp_size);
 }
 
-template<typename Type>
-inline long pyList<Type>::_transform_index(const long index) const{
-    long act_index = (index>=0) ? (index) : (index + length);
-    act_index = (act_index + Head + 1) % allocated;
-    return act_index;
+template<typename Item, typename Compare>
+long pyTimSort<Item, Compare>::_min_run_length(long n){
+    long r = 0;
+    while(n >= MIN_MERGE){
+        r |= (n & 1);
+        n >>= 1;
+    }
+    return n + r;
 }
 
-template<typename Type>
-inline long pyList<Type>::_untransform_index(const long index) const{
-    if(Head < Tail){
-        return index - Head - 1;
+template<typename Item, typename Compare>
+long pyTimSort<Item, Compare>::_count_run_and_make_ascending(const long lo, const long hi){
+    long run_hi = lo + 1;
+    if(run_hi == hi){
+        return 1;
     }
-    else {
-        if(index > Head){
-            return index - Head - 1;
+    if(comp(Array[run_hi++], Array[lo])){
+        while(run_hi < hi && comp(Array[run_hi], Array[run_hi - 1])){
+            run_hi++;
         }
-        else{
-            return index + allocated - Head - 1;
+        std::reverse(Array + lo, Array + run_hi);
+    }
+    else{
+        while(run_hi < hi && !comp(Array[run_hi], Array[run_hi - 1])){
+            run_hi++;
         }
     }
+    return run_hi - lo;
 }
 
-template<typename Type>
-long pyList<Type>::_clamp(const long value, const long min_value, const long max_value) const {
-    if(value < min_value){
-        return min_value;
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_binary_sort(const long lo, const long hi, long start){
+    if(start == lo){
+        start++;
     }
-    else if(value > max_value){
-        return max_value;
+    for(; start < hi; start++){
+        Item pivot = std::move(Array[start]);
+        long left = lo;
+        long right = start;
+        while(left < right){
+            long mid = (left + right) >> 1;
+            if(comp(pivot, Array[mid])){
+                right = mid;
+            }
+            else{
+                left = mid + 1;
+            }
+        }
+        std::move_backward(Array + left, Array + start, Array + start + 1);
+        Array[left] = std::move(pivot);
     }
-    return value;
 }
 
-template<typename Type>
-long pyList<Type>::_len_between(const long start, const long stop) const {
-    if(start <= stop){
-        return stop - start;
+template<typename Item, typename Compare>
+long pyTimSort<Item, Compare>::_gallop_left(const Item & key, const Item * a, const long len, const long hint){
+    long last_ofs = 0;
+    long ofs = 1;
+    if(comp(a[hint], key)){
+        long max_ofs = len - hint;
+        while(ofs < max_ofs && comp(a[hint + ofs], key)){
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if(ofs > max_ofs){
+            ofs = max_ofs;
+        }
+        last_ofs += hint;
+        ofs += hint;
     }
     else{
-        return allocated - start + stop;
+        long max_ofs = hint + 1;
+        while(ofs < max_ofs && !comp(a[hint - ofs], key)){
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if(ofs > max_ofs){
+            ofs = max_ofs;
+        }
+        long tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
     }
+    last_ofs++;
+    while(last_ofs < ofs){
+        long m = last_ofs + ((ofs - last_ofs) >> 1);
+        if(comp(a[m], key)){
+            last_ofs = m + 1;
+        }
+        else{
+            ofs = m;
+        }
+    }
+    return ofs;
 }
 
-template<typename Type>
-bool pyList<Type>::_is_valid_index(const long index) const {
-    long k = _untransform_index(index);
-    if(k<0 || k>=length){
-        return false;
+template<typename Item, typename Compare>
+long pyTimSort<Item, Compare>::_gallop_right(const Item & key, const Item * a, const long len, const long hint){
+    long last_ofs = 0;
+    long ofs = 1;
+    if(comp(key, a[hint])){
+        long max_ofs = hint + 1;
+        while(ofs < max_ofs && comp(key, a[hint - ofs])){
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if(ofs > max_ofs){
+            ofs = max_ofs;
+        }
+        long tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
     }
     else{
-        return true;
+        long max_ofs = len - hint;
+        while(ofs < max_ofs && !comp(key, a[hint + ofs])){
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if(ofs > max_ofs){
+            ofs = max_ofs;
+        }
+        last_ofs += hint;
+        ofs += hint;
+    }
+    last_ofs++;
+    while(last_ofs < ofs){
+        long m = last_ofs + ((ofs - last_ofs) >> 1);
+        if(comp(key, a[m])){
+            ofs = m;
+        }
+        else{
+            last_ofs = m + 1;
+        }
     }
+    return ofs;
 }
 
-template<typename Type>
-void pyList<Type>::_resize_if_necessary(){
-    size_t newsize;
-    if(length >= allocated-1){
-        newsize = RESIZE_FACTOR*allocated;
-    }
-    else if(length < allocated/(RESIZE_FACTOR*RESIZE_FACTOR) && allocated/RESIZE_FACTOR > INITIAL_ARRAY_SIZE){
-        newsize = allocated/RESIZE_FACTOR;
-    }
-    else{
-        return;
-    }
-    Type *temp = new Type[newsize];
-    long index = Head;
-    temp[0] = Array[Head];
-    for(unsigned long i=0; i< length; i++){
-        index = _next_index(index);
-        temp[i+1] = Array[index];
+template<typename Item, typename Compare>
+Item * pyTimSort<Item, Compare>::_fill_temp(Item * source, const long n){
+    if(temp_size < n){
+        std::allocator<Item>().deallocate(temp, temp_size);
+        temp = nullptr;
+        temp_size = 0;
+        long size = n > 256 ? n : 256;
+        temp = std::allocator<Item>().allocate(size);
+        temp_size = size;
     }
-    Head = 0;
-    Tail = length;
-    delete[] Array;
-    Array = temp;
-    allocated = newsize;
+    std::uninitialized_move(source, source + n, temp);
+    temp_live = n;
+    return temp;
 }
 
-template<typename Type>
-long pyList<Type>::_partition(const long start, const long stop){
-    long i=start;
-    long j=stop;
-    while(1){
-        int all_elements_equal_flag = 1;
-        while(i != _next_index(stop)  && Array[i] <= Array[start]){
-            if(Array[i] != Array[start]){
-                all_elements_equal_flag = 0;
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_release_temp(){
+    std::destroy(temp, temp + temp_live);
+    temp_live = 0;
+}
+
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_merge_collapse(){
+    while(stack_size > 1){
+        int n = stack_size - 2;
+        if((n > 0 && run_len[n-1] <= run_len[n] + run_len[n+1]) || (n > 1 && run_len[n-2] <= run_len[n] + run_len[n-1])){
+            if(run_len[n-1] < run_len[n+1]){
+                n--;
             }
-            i = _next_index(i);
         }
-        if(all_elements_equal_flag == 1 && i == _next_index(stop)){
-            return -1;
-        }
-        while(j != start && Array[j] > Array[start]){
-            j = _prev_index(j);
-        }
-        if(_next_index(j) == i){
+        else if(run_len[n] > run_len[n+1]){
             break;
         }
-        std::swap(Array[i], Array[j]);
+        _merge_at(n);
     }
-    std::swap(Array[start], Array[j]);
-    return j;
 }
 
-template<typename Type>
-void pyList<Type>::_quicksort(const long start, const long stop){
-    if(start == stop){
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_merge_force_collapse(){
+    while(stack_size > 1){
+        int n = stack_size - 2;
+        if(n > 0 && run_len[n-1] < run_len[n+1]){
+            n--;
+        }
+        _merge_at(n);
+    }
+}
+
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_merge_at(const int i){
+    long base1 = run_base[i];
+    long len1 = run_len[i];
+    long base2 = run_base[i+1];
+    long len2 = run_len[i+1];
+    run_len[i] = len1 + len2;
+    if(i == stack_size - 3){
+        run_base[i+1] = run_base[i+2];
+        run_len[i+1] = run_len[i+2];
+    }
+    stack_size--;
+    long k = _gallop_right(Array[base2], Array + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if(len1 == 0){
         return;
     }
-    if(_len_between(start, stop) <= 64){
-        for(long i=_next_index(start); i!=_next_index(stop); i = _next_index(i)){
-            Type temp = Array[i];
-            long j = _prev_index(i);
-            long k = _next_index(j);
-            while(j != _prev_index(start) && (Array[j] > temp)){
-                std::swap(Array[k], Array[j]);
-                k = j;
-                j = _prev_index(j);
-            }
-            Array[k] = temp;
-        }
+    len2 = _gallop_left(Array[base1 + len1 - 1], Array + base2, len2, len2 - 1);
+    if(len2 == 0){
         return;
     }
-    long mid_index;
-    if(start < stop){
-        mid_index = (start + stop)/2;
-        //mid_index = _py_median_of_index(List->Array, start + rand()%(stop-start+1), start + rand()%(stop-start+1), start + rand()%(stop-start+1));
+    if(len1 <= len2){
+        _merge_lo(base1, len1, base2, len2);
     }
     else{
-        mid_index = (start + (allocated - start + stop)/2 )% allocated;
-        //mid_index = _py_median_of_index(List->Array,(start + (rand()%(List->allocated - start + stop+1)))%List->allocated,
-                                        //(start + (rand()%(List->allocated - start + stop+1)))%List->allocated,
-                                        //(start + (rand()%(List->allocated - start + stop+1)))%List->allocated);
+        _merge_hi(base1, len1, base2, len2);
+    }
+}
+
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_merge_lo(long base1, long len1, long base2, long len2){
+    Item *a = Array;
+    Item *tmp = _fill_temp(a + base1, len1);
+    long cursor1 = 0;
+    long cursor2 = base2;
+    long dest = base1;
+    a[dest++] = std::move(a[cursor2++]);
+    if(--len2 == 0){
+        std::move(tmp + cursor1, tmp + cursor1 + len1, a + dest);
+        _release_temp();
+        return;
     }
-    std::swap(Array[start], Array[mid_index]);
-    long p = _partition(start,stop);
-    if(p == -1){
+    if(len1 == 1){
+        std::move(a + cursor2, a + cursor2 + len2, a + dest);
+        a[dest + len2] = std::move(tmp[cursor1]);
+        _release_temp();
         return;
     }
-    if(p != start){
-        _quicksort(start,_prev_index(p));
+    long gallop = min_gallop;
+    while(true){
+        long count1 = 0;
+        long count2 = 0;
+        do{
+            if(comp(a[cursor2], tmp[cursor1])){
+                a[dest++] = std::move(a[cursor2++]);
+                count2++;
+                count1 = 0;
+                if(--len2 == 0){
+                    goto done;
+                }
+            }
+            else{
+                a[dest++] = std::move(tmp[cursor1++]);
+                count1++;
+                count2 = 0;
+                if(--len1 == 1){
+                    goto done;
+                }
+            }
+        }while((count1 | count2) < gallop);
+        do{
+            count1 = _gallop_right(a[cursor2], tmp + cursor1, len1, 0);
+            if(count1 != 0){
+                std::move(tmp + cursor1, tmp + cursor1 + count1, a + dest);
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+                if(len1 <= 1){
+                    goto done;
+                }
+            }
+            a[dest++] = std::move(a[cursor2++]);
+            if(--len2 == 0){
+                goto done;
+            }
+            count2 = _gallop_left(tmp[cursor1], a + cursor2, len2, 0);
+            if(count2 != 0){
+                std::move(a + cursor2, a + cursor2 + count2, a + dest);
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+                if(len2 == 0){
+                    goto done;
+                }
+            }
+            a[dest++] = std::move(tmp[cursor1++]);
+            if(--len1 == 1){
+                goto done;
+            }
+            gallop--;
+        }while(count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+        if(gallop < 0){
+            gallop = 0;
+        }
+        gallop += 2;
+    }
+done:
+    min_gallop = gallop < 1 ? 1 : gallop;
+    if(len1 == 1){
+        std::move(a + cursor2, a + cursor2 + len2, a + dest);
+        a[dest + len2] = std::move(tmp[cursor1]);
     }
-    if(p != stop){
-        _quicksort(_next_index(p),stop);
+    else if(len1 > 1){
+        std::move(tmp + cursor1, tmp + cursor1 + len1, a + dest);
     }
+    _release_temp();
 }
 
-template<typename Type>
-void pyList<Type>::_testsort() const {
-    Type prev = (*this)[0];
-    for(unsigned long i=1; i < length; i++){
-        if((*this)[i]< prev){
-            std::cerr << "Incorrect sort" << std::endl;
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::_merge_hi(long base1, long len1, long base2, long len2){
+    Item *a = Array;
+    Item *tmp = _fill_temp(a + base2, len2);
+    long cursor1 = base1 + len1 - 1;
+    long cursor2 = len2 - 1;
+    long dest = base2 + len2 - 1;
+    a[dest--] = std::move(a[cursor1--]);
+    if(--len1 == 0){
+        std::move(tmp, tmp + len2, a + dest - (len2 - 1));
+        _release_temp();
+        return;
+    }
+    if(len2 == 1){
+        dest -= len1;
+        cursor1 -= len1;
+        std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+        a[dest] = std::move(tmp[cursor2]);
+        _release_temp();
+        return;
+    }
+    long gallop = min_gallop;
+    while(true){
+        long count1 = 0;
+        long count2 = 0;
+        do{
+            if(comp(tmp[cursor2], a[cursor1])){
+                a[dest--] = std::move(a[cursor1--]);
+                count1++;
+                count2 = 0;
+                if(--len1 == 0){
+                    goto done;
+                }
+            }
+            else{
+                a[dest--] = std::move(tmp[cursor2--]);
+                count2++;
+                count1 = 0;
+                if(--len2 == 1){
+                    goto done;
+                }
+            }
+        }while((count1 | count2) < gallop);
+        do{
+            count1 = len1 - _gallop_right(tmp[cursor2], a + base1, len1, len1 - 1);
+            if(count1 != 0){
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + count1, a + dest + 1 + count1);
+                if(len1 == 0){
+                    goto done;
+                }
+            }
+            a[dest--] = std::move(tmp[cursor2--]);
+            if(--len2 == 1){
+                goto done;
+            }
+            count2 = len2 - _gallop_left(a[cursor1], tmp, len2, len2 - 1);
+            if(count2 != 0){
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                std::move(tmp + cursor2 + 1, tmp + cursor2 + 1 + count2, a + dest + 1);
+                if(len2 <= 1){
+                    goto done;
+                }
+            }
+            a[dest--] = std::move(a[cursor1--]);
+            if(--len1 == 0){
+                goto done;
+            }
+            gallop--;
+        }while(count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+        if(gallop < 0){
+            gallop = 0;
         }
-        prev = (*this)[i];
+        gallop += 2;
     }
-    std::cout << "Correct sort" << std::endl;
-}
-
-template<typename Type>
-inline long pyList<Type>::len() const{
-    return length;
+done:
+    min_gallop = gallop < 1 ? 1 : gallop;
+    if(len2 == 1){
+        dest -= len1;
+        cursor1 -= len1;
+        std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+        a[dest] = std::move(tmp[cursor2]);
+    }
+    else if(len2 > 1){
+        std::move(tmp, tmp + len2, a + dest - (len2 - 1));
+    }
+    _release_temp();
 }
 
-template<typename Type>
-void pyList<Type>::sort(){
-    if(length <= 1){
+template<typename Item, typename Compare>
+void pyTimSort<Item, Compare>::sort(Item * first, const long n, Compare compare){
+    if(n < 2){
         return;
     }
-    _quicksort(_next_index(Head), Tail);
-}
+    pyTimSort<Item, Compare> sorter(first, compare);
+    if(n < MIN_MERGE){
+        long run = sorter._count_run_and_make_ascending(0, n);
+        sorter._binary_sort(0, n, run);
+        return;
+    }
+    long min_run = _min_run_length(n);
+    long lo = 0;
+    long remaining = n;
+    do{
+        long run = sorter._count_run_and_make_ascending(lo, n);
+        if(run < min_run){
+            long force = remaining <= min_run ? remaining : min_run;
+            sorter._binary_sort(lo, lo + force, lo + run);
+            run = force;
+        }
+        sorter.run_base[sorter.stack_size] = lo;
+        sorter.run_len[sorter.stack_size] = run;
+        sorter.stack_size++;
+        sorter._merge_collapse();
+        lo += run;
+        remaining -= run;
+    }while(remaining != 0);
+    sorter._merge_force_collapse();
+}
 
-template<typename Type>
-void pyList<Type>::reverse(){
-    long k = length/2;
-    long index1 = _next_index(Head);
-    long index2 = Tail;
-    for(unsigned long i=0; i<k; i++){
-        std::swap(Array[index1], Array[index2]);
-        index1 = _next_index(index1);
-        index2 = _prev_index(index2);
+template<typename Item, typename Compare, size_t Arity = 2>
+class pyHeap{
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+    static void sift_up(Item *, const long, long, Compare);
+    static void sift_down(Item *, const long, long, Compare);
+    static void make(Item *, const long, Compare);
+    template<typename List>
+    static Item * data(List &);
+};
+
+template<typename Item, typename Compare, size_t Arity>
+void pyHeap<Item, Compare, Arity>::sift_up(Item * heap, const long start, long position, Compare less){
+    Item item = std::move(heap[position]);
+    while(position > start){
+        long parent = (position - 1) / (long)Arity;
+        if(!less(item, heap[parent])){
+            break;
+        }
+        heap[position] = std::move(heap[parent]);
+        position = parent;
     }
+    heap[position] = std::move(item);
 }
 
-template<typename Type>
-Type pyList<Type>::get(const long index) const {
-    if(index < length && index >= -length){
-        long act_index = _transform_index(index);
-        return Array[act_index];
+template<typename Item, typename Compare, size_t Arity>
+void pyHeap<Item, Compare, Arity>::sift_down(Item * heap, const long n, long position, Compare less){
+    long start = position;
+    Item item = std::move(heap[position]);
+    long child = (long)Arity * position + 1;
+    while(child + (long)Arity <= n){
+        long best = child;
+        for(long i = 1; i < (long)Arity; i++){
+            best = less(heap[child + i], heap[best]) ? child + i : best;
+        }
+        heap[position] = std::move(heap[best]);
+        position = best;
+        child = (long)Arity * position + 1;
     }
-    else{
-        throw std::invalid_argument("IndexError: list index out of range");
+    if(child < n){
+        long best = child;
+        for(long i = child + 1; i < n; i++){
+            if(less(heap[i], heap[best])){
+                best = i;
+            }
+        }
+        heap[position] = std::move(heap[best]);
+        position = best;
     }
+    heap[position] = std::move(item);
+    sift_up(heap, start, position, less);
 }
 
-template<typename Type>
-void pyList<Type>::set(const long index, const Type key){
-    if(index < length && index >= -length){
-        long act_index = _transform_index(index);
-        Array[act_index] = key;
+template<typename Item, typename Compare, size_t Arity>
+void pyHeap<Item, Compare, Arity>::make(Item * heap, const long n, Compare less){
+    for(long i = (n - 2) / (long)Arity; i >= 0 && n > 1; i--){
+        sift_down(heap, n, i, less);
     }
-    else{
-        throw std::invalid_argument("list index out of range");
+}
+
+template<typename Item, typename Compare, size_t Arity>
+template<typename List>
+Item * pyHeap<Item, Compare, Arity>::data(List & list){
+    list._detach();
+    if(list.length == 0){
+        return nullptr;
     }
+    list._linearize();
+    return list.Array + list._next_index(list.Head);
 }
 
-template<typename Type>
-void pyList<Type>::append(const Type key){
-    _resize_if_necessary();
-    Tail = (Tail + 1) % allocated;
-    ++length;
-    Array[Tail] = key;
+template<typename Item>
+class pyRadixSort{
+    using Key = typename std::conditional<sizeof(Item) == 1, uint8_t,
+                typename std::conditional<sizeof(Item) == 2, uint16_t,
+                typename std::conditional<sizeof(Item) == 4, uint32_t, uint64_t>::type>::type>::type;
+    static constexpr long DIGITS = sizeof(Item);
+    static constexpr long RADIX = 256;
+    static constexpr Key SIGN = Key(Key(1) << (sizeof(Key) * CHAR_BIT - 1));
+
+    static Key _key(Item, const bool);
+
+public:
+    static constexpr bool enabled = (std::is_integral<Item>::value && !std::is_same<Item, bool>::value) ||
+                                    (std::is_floating_point<Item>::value && std::numeric_limits<Item>::is_iec559 &&
+                                     (sizeof(Item) == 4 || sizeof(Item) == 8));
+
+    static void sort(Item *, const long, const bool);
+};
+
+template<typename Item>
+typename pyRadixSort<Item>::Key pyRadixSort<Item>::_key(Item value, const bool reverse){
+    Key bits;
+    if constexpr(std::is_floating_point<Item>::value){
+        if(value == 0){
+            value = 0;
+        }
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = (bits & SIGN) ? Key(~bits) : Key(bits | SIGN);
+    }
+    else{
+        bits = Key(value);
+        if constexpr(std::is_signed<Item>::value){
+            bits ^= SIGN;
+        }
+    }
+    return reverse ? Key(~bits) : bits;
 }
 
-template<typename Type>
-Type pyList<Type>::max(){
-    if(length == 0){
-        throw std::domain_error("max of empty list");
+template<typename Item>
+void pyRadixSort<Item>::sort(Item * first, const long n, const bool reverse){
+    std::vector<long> counts(DIGITS * RADIX, 0);
+    for(long i=0; i<n; i++){
+        Key key = _key(first[i], reverse);
+        for(long d=0; d<DIGITS; d++){
+            counts[d*RADIX + ((key >> (d * 8)) & (RADIX - 1))]++;
+        }
     }
-    Type maximum = (*this)[0];
-    long index1 = Head;
-    while(index1 != Tail){
-        index1 = _next_index(index1);
-        if(Array[index1] > maximum){
-            maximum = Array[index1];
+    std::unique_ptr<Item[]> scratch(new Item[n]);
+    Item *from = first;
+    Item *to = scratch.get();
+    for(long d=0; d<DIGITS; d++){
+        long *count = counts.data() + d*RADIX;
+        if(count[(_key(from[0], reverse) >> (d * 8)) & (RADIX - 1)] == n){
+            continue;
+        }
+        long offset = 0;
+        for(long b=0; b<RADIX; b++){
+            long size = count[b];
+            count[b] = offset;
+            offset += size;
+        }
+        for(long i=0; i<n; i++){
+            to[count[(_key(from[i], reverse) >> (d * 8)) & (RADIX - 1)]++] = from[i];
         }
+        std::swap(from, to);
+    }
+    if(from != first){
+        std::memcpy(first, from, n * sizeof(Item));
     }
-    return maximum;
 }
 
-template<typename Type>
-Type pyList<Type>::min(){
-    if(length == 0){
-        throw std::domain_error("min of empty list");
+class pyThreadPool{
+    struct Queue{
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    size_t worker_count;
+    std::unique_ptr<Queue[]> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next_queue;
+    std::atomic<long> queued;
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    bool _pop(const size_t, std::function<void()> &);
+    void _work(const size_t);
+
+public:
+    explicit pyThreadPool(const size_t);
+    pyThreadPool(const pyThreadPool &) = delete;
+    pyThreadPool & operator = (const pyThreadPool &) = delete;
+    ~pyThreadPool();
+    size_t size() const { return worker_count; }
+    void submit(std::function<void()>);
+    bool run_pending();
+    static pyThreadPool & instance();
+};
+
+pyThreadPool::pyThreadPool(const size_t count){
+    worker_count = count > 0 ? count : 1;
+    queues.reset(new Queue[worker_count]);
+    next_queue = 0;
+    queued = 0;
+    stopping = false;
+    for(size_t i=0; i<worker_count; i++){
+        workers.emplace_back(&pyThreadPool::_work, this, i);
     }
-    Type minimum = (*this)[0];
-    long index1 = Head;
-    while(index1 != Tail){
-        index1 = _next_index(index1);
-        if(Array[index1] < minimum){
-            minimum = Array[index1];
+}
+
+pyThreadPool::~pyThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread & worker:workers){
+        worker.join();
+    }
+}
+
+pyThreadPool & pyThreadPool::instance(){
+    static pyThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+bool pyThreadPool::_pop(const size_t index, std::function<void()> & task){
+    {
+        Queue & own = queues[index];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if(!own.tasks.empty()){
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued;
+            return true;
         }
     }
-    return minimum;
+    for(size_t i=1; i<worker_count; i++){
+        Queue & victim = queues[(index + i) % worker_count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.tasks.empty()){
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
 }
 
-template<typename Type>
-Type pyList<Type>::sum(){
-    Type total = 0;
-    long index1 = Head;
-    while(index1 != Tail){
-        index1 = _next_index(index1);
-        total = total + Array[index1];
+void pyThreadPool::_work(const size_t index){
+    std::function<void()> task;
+    while(true){
+        if(_pop(index, task)){
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleep_lock);
+        wake.wait(guard, [this]{ return stopping || queued > 0; });
+        if(stopping && queued == 0){
+            return;
+        }
     }
-    return total;
 }
 
-template<typename Type>
-void pyList<Type>::extend(const pyList<Type> & List){
-    long index = List.Head;
-    for(unsigned long i=0; i<List.length; i++){
-        _resize_if_necessary();
-        Tail = _next_index(Tail);
-        index = List._next_index(index);
-        Array[Tail] = List.Array[index];
+void pyThreadPool::submit(std::function<void()> task){
+    Queue & target = queues[next_queue++ % worker_count];
+    {
+        std::lock_guard<std::mutex> guard(target.lock);
+        target.tasks.push_back(std::move(task));
     }
-    length += List.length;
+    ++queued;
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+    }
+    wake.notify_one();
 }
 
-template<typename Type>
-pyList<Type> pyList<Type>::slice(const long start = 0, const long stop = LONG_MAX, const long step = 1) const {
-    if(step == 0){
-        throw std::invalid_argument("step cannot be zero");
+bool pyThreadPool::run_pending(){
+    std::function<void()> task;
+    if(_pop(next_queue % worker_count, task)){
+        task();
+        return true;
     }
-    long stop_clamped = _clamp(stop,-length-1,length);
-    stop_clamped = stop_clamped>=0? stop_clamped:stop_clamped + length;
-    long start_clamped = _clamp(start,-length, length-1);
-    start_clamped = start_clamped>=0? start_clamped: start_clamped + length;
-    pyList newList((std::abs(stop_clamped - start_clamped/step)+1)*2);
-    newList.Head = 0;
-    long ctr = 0;
-    long step_sgn = step/std::abs(step);
-    for(long i = start_clamped; step_sgn*i < step_sgn*stop_clamped ; i += step){
-        newList.Array[++ctr] = Array[_transform_index(i)];
+    return false;
+}
+
+class pyTaskGroup{
+    pyThreadPool & pool;
+    std::atomic<long> pending;
+    std::mutex error_lock;
+    std::exception_ptr error;
+
+public:
+    explicit pyTaskGroup(pyThreadPool &);
+    pyTaskGroup(const pyTaskGroup &) = delete;
+    pyTaskGroup & operator = (const pyTaskGroup &) = delete;
+    ~pyTaskGroup();
+    void run(std::function<void()>);
+    void wait();
+};
+
+pyTaskGroup::pyTaskGroup(pyThreadPool & source) : pool(source){
+    pending = 0;
+}
+
+pyTaskGroup::~pyTaskGroup(){
+    while(pending > 0){
+        if(!pool.run_pending()){
+            std::this_thread::yield();
+        }
     }
-    newList.Tail = ctr;
-    newList.length = ctr;
-    return newList;
 }
 
-template<typename Type>
-Type pyList<Type>::pop(const long index = -1){
-    if(index<length && -index<=length){
-        long act_index = _transform_index(index);
-        Type key = Array[act_index];
-        if(_len_between(act_index,Tail) < length/2){
-            while(act_index != Tail){
-                long next_index = _next_index(act_index);
-                Array[act_index] = Array[next_index];
-                act_index = next_index;
-            }
-            Tail = _prev_index(Tail);
+void pyTaskGroup::run(std::function<void()> task){
+    ++pending;
+    pool.submit([this, task]{
+        try{
+            task();
         }
-        else{
-            long head_next = _next_index(Head);
-            while(act_index != head_next){
-                long prev_index = _prev_index(act_index);
-                Array[act_index] = Array[prev_index];
-                act_index = prev_index;
+        catch(...){
+            std::lock_guard<std::mutex> guard(error_lock);
+            if(!error){
+                error = std::current_exception();
             }
-            Head = head_next;
         }
-        _resize_if_necessary();
-        --length;
-        return key;
+        --pending;
+    });
+}
+
+void pyTaskGroup::wait(){
+    while(pending > 0){
+        if(!pool.run_pending()){
+            std::this_thread::yield();
+        }
     }
-    else{
-        throw std::invalid_argument("pop index out of range");
+    if(error){
+        std::exception_ptr thrown = error;
+        error = nullptr;
+        std::rethrow_exception(thrown);
     }
 }
 
-template<typename Type>
-void pyList<Type>::remove(const Type key){
-    long index = Head;
-    while(index != Tail){
-        index = _next_index(index);
-        if(Array[index] == key){
-            index = _untransform_index(index);
-            pop(index);
-            return;
+template<typename Item, typename Compare>
+class pyParallelSort{
+    static const long MIN_CHUNK = 1 << 14;
+    static const long OVERSAMPLE = 4;
+
+    struct Buffer{
+        std::allocator<Item> allocator;
+        Item *data;
+        long size;
+        std::vector<long> start;
+        std::vector<long> built;
+
+        Buffer(const long n, const std::vector<long> & offsets) : data(allocator.allocate(n)), size(n), start(offsets), built(offsets.size(), 0){}
+        Buffer(const Buffer &) = delete;
+        Buffer & operator = (const Buffer &) = delete;
+        ~Buffer(){
+            for(size_t j=0; j<built.size(); j++){
+                std::destroy(data + start[j], data + start[j] + built[j]);
+            }
+            allocator.deallocate(data, size);
         }
+    };
+
+public:
+    static void sort(Item *, const long, Compare, pyThreadPool &);
+};
+
+template<typename Item, typename Compare>
+void pyParallelSort<Item, Compare>::sort(Item * first, const long n, Compare comp, pyThreadPool & pool){
+    long k = n / MIN_CHUNK;
+    if(k > (long)pool.size() + 1){
+        k = pool.size() + 1;
     }
-    throw std::invalid_argument("Value not in list");
+    if(k < 2){
+        pyTimSort<Item, Compare>::sort(first, n, comp);
+        return;
+    }
+    pyTaskGroup group(pool);
+    std::vector<long> bounds(k + 1);
+    for(long i=0; i<=k; i++){
+        bounds[i] = n * i / k;
+    }
+    for(long i=0; i<k; i++){
+        group.run([=, &bounds]{ pyTimSort<Item, Compare>::sort(first + bounds[i], bounds[i+1] - bounds[i], comp); });
+    }
+    group.wait();
+
+    auto indirect = [&comp](const Item * a, const Item * b){ return comp(*a, *b); };
+    std::vector<const Item *> samples;
+    long per_chunk = OVERSAMPLE * k;
+    for(long i=0; i<k; i++){
+        long size = bounds[i+1] - bounds[i];
+        for(long s=1; s<=per_chunk; s++){
+            samples.push_back(first + bounds[i] + size * s / (per_chunk + 1));
+        }
+    }
+    pyTimSort<const Item *, decltype(indirect)>::sort(samples.data(), samples.size(), indirect);
+
+    std::vector<long> split(k * (k + 1));
+    for(long i=0; i<k; i++){
+        split[i*(k+1)] = bounds[i];
+        split[i*(k+1) + k] = bounds[i+1];
+        for(long j=1; j<k; j++){
+            const Item & splitter = *samples[j * samples.size() / k];
+            split[i*(k+1) + j] = std::lower_bound(first + bounds[i], first + bounds[i+1], splitter, comp) - first;
+        }
+    }
+    std::vector<long> offsets(k + 1, 0);
+    for(long j=0; j<k; j++){
+        offsets[j+1] = offsets[j];
+        for(long i=0; i<k; i++){
+            offsets[j+1] += split[i*(k+1) + j + 1] - split[i*(k+1) + j];
+        }
+    }
+
+    Buffer temp(n, offsets);
+    for(long j=0; j<k; j++){
+        group.run([=, &split, &offsets, &comp, &temp]{
+            std::vector<long> cursor(k);
+            std::vector<long> heap;
+            for(long i=0; i<k; i++){
+                cursor[i] = split[i*(k+1) + j];
+                if(cursor[i] < split[i*(k+1) + j + 1]){
+                    heap.push_back(i);
+                }
+            }
+            auto earlier = [&](const long a, const long b){
+                if(comp(first[cursor[a]], first[cursor[b]])){
+                    return true;
+                }
+                return a < b && !comp(first[cursor[b]], first[cursor[a]]);
+            };
+            pyHeap<long, decltype(earlier)>::make(heap.data(), heap.size(), earlier);
+            Item *out = temp.data + offsets[j];
+            long &built = temp.built[j];
+            while(!heap.empty()){
+                long best = heap[0];
+                ::new (static_cast<void *>(out + built)) Item(std::move(first[cursor[best]++]));
+                ++built;
+                if(cursor[best] == split[best*(k+1) + j + 1]){
+                    heap[0] = heap.back();
+                    heap.pop_back();
+                }
+                if(heap.size() > 1){
+                    pyHeap<long, decltype(earlier)>::sift_down(heap.data(), heap.size(), 0, earlier);
+                }
+            }
+        });
+    }
+    group.wait();
+    for(long j=0; j<k; j++){
+        group.run([=, &offsets, &temp]{
+            std::move(temp.data + offsets[j], temp.data + offsets[j+1], first + offsets[j]);
+            std::destroy(temp.data + offsets[j], temp.data + offsets[j+1]);
+            temp.built[j] = 0;
+        });
+    }
+    group.wait();
 }
 
-template<typename Type>
-void pyList<Type>::clear(){
-    delete[] Array;
-    Head = 0;
-    Tail = 0;
-    length = 0;
-    allocated = INITIAL_ARRAY_SIZE;
-    Array = new Type[allocated];
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PYLIST_AVX2_DISPATCH 1
+#endif
+
+inline bool pyHasAvx2(){
+#ifdef PYLIST_AVX2_DISPATCH
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
 }
 
-template<typename Type>
-long pyList<Type>::count(const Type key) const{
-    long index1 = Head;
-    long ctr = 0;
-    while(index1 != Tail){
-        index1 = _next_index(index1);
-        if(Array[index1] == key){
-            ctr++;
+#ifdef __GNUC__
+template<typename Item, size_t Bytes>
+struct pySimdKernel{
+    typedef Item Vector __attribute__((vector_size(Bytes)));
+    typedef decltype(Vector() == Vector()) Mask;
+    static constexpr long LANES = Bytes / sizeof(Item);
+    static constexpr long FLUSH = sizeof(Item) == 1 ? 0x7F : 0x7FFF;
+
+    __attribute__((always_inline)) static inline Item sum(const Item * first, const long n, Item total){
+        Vector acc[4] = {};
+        long i = 0;
+        for(; i + 4*LANES <= n; i += 4*LANES){
+            for(long k=0; k<4; k++){
+                Vector v;
+                std::memcpy(&v, first + i + k*LANES, sizeof(v));
+                acc[k] += v;
+            }
+        }
+        for(; i + LANES <= n; i += LANES){
+            Vector v;
+            std::memcpy(&v, first + i, sizeof(v));
+            acc[0] += v;
         }
+        acc[0] = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        for(long l=0; l<LANES; l++){
+            total = total + acc[0][l];
+        }
+        for(; i<n; i++){
+            total = total + first[i];
+        }
+        return total;
     }
-    return ctr;
-}
 
-template<typename Type>
-long pyList<Type>::index(const Type key, const long start = 0, const long stop = LONG_MAX){
+    __attribute__((always_inline)) static inline Item max(const Item * first, const long n, Item maximum){
+        Vector acc = Vector() + maximum;
+        long i = 0;
+        for(; i + LANES <= n; i += LANES){
+            Vector v;
+            std::memcpy(&v, first + i, sizeof(v));
+            acc = v > acc ? v : acc;
+        }
+        for(long l=0; l<LANES; l++){
+            if(acc[l] > maximum){
+                maximum = acc[l];
+            }
+        }
+        for(; i<n; i++){
+            if(first[i] > maximum){
+                maximum = first[i];
+            }
+        }
+        return maximum;
+    }
 
-    long stop_clamped = _clamp(stop,-length-1,length);
-    stop_clamped = stop_clamped>=0? stop_clamped:stop_clamped + length;
-    long start_clamped = _clamp(start,-length, length-1);
-    start_clamped = start_clamped>=0? start_clamped: start_clamped + length;
+    __attribute__((always_inline)) static inline Item min(const Item * first, const long n, Item minimum){
+        Vector acc = Vector() + minimum;
+        long i = 0;
+        for(; i + LANES <= n; i += LANES){
+            Vector v;
+            std::memcpy(&v, first + i, sizeof(v));
+            acc = v < acc ? v : acc;
+        }
+        for(long l=0; l<LANES; l++){
+            if(acc[l] < minimum){
+                minimum = acc[l];
+            }
+        }
+        for(; i<n; i++){
+            if(first[i] < minimum){
+                minimum = first[i];
+            }
+        }
+        return minimum;
+    }
 
-    long index1 = _transform_index(start_clamped);
-    long index2 = _transform_index(stop_clamped);
+    __attribute__((always_inline)) static inline long count(const Item * first, const long n, const Item key){
+        Vector keys = Vector() + key;
+        long ctr = 0;
+        long i = 0;
+        while(i + LANES <= n){
+            Mask hits = {};
+            long block = std::min(n - LANES + 1, i + LANES * FLUSH);
+            for(; i < block; i += LANES){
+                Vector v;
+                std::memcpy(&v, first + i, sizeof(v));
+                hits -= (v == keys);
+            }
+            for(long l=0; l<LANES; l++){
+                ctr += hits[l];
+            }
+        }
+        for(; i<n; i++){
+            if(first[i] == key){
+                ctr++;
+            }
+        }
+        return ctr;
+    }
 
-    while(index1 != index2){
-        if(!_is_valid_index(index1)){
-            break;
+    __attribute__((always_inline)) static inline bool any(const Mask & mask){
+        uint64_t words[Bytes / 8];
+        std::memcpy(words, &mask, sizeof(words));
+        uint64_t bits = 0;
+        for(size_t w=0; w<Bytes/8; w++){
+            bits |= words[w];
+        }
+        return bits != 0;
+    }
+
+    __attribute__((always_inline)) static inline long find(const Item * first, const long n, const Item key){
+        Vector keys = Vector() + key;
+        long i = 0;
+        for(; i + LANES <= n; i += LANES){
+            Vector v;
+            std::memcpy(&v, first + i, sizeof(v));
+            if(any(v == keys)){
+                break;
+            }
         }
-        if(Array[index1] == key){
-            return _untransform_index(index1);
+        for(; i<n; i++){
+            if(first[i] == key){
+                return i;
+            }
         }
-        index1 = _next_index(index1);
+        return n;
+    }
+
+    __attribute__((always_inline)) static inline long mismatch(const Item * a, const Item * b, const long n){
+        long i = 0;
+        for(; i + LANES <= n; i += LANES){
+            Vector va, vb;
+            std::memcpy(&va, a + i, sizeof(va));
+            std::memcpy(&vb, b + i, sizeof(vb));
+            if(any(va != vb)){
+                break;
+            }
+        }
+        for(; i<n; i++){
+            if(a[i] != b[i]){
+                return i;
+            }
+        }
+        return n;
+    }
+};
+#endif
+
+template<typename Item>
+struct pyBitwiseComparable : std::integral_constant<bool, std::is_integral<Item>::value || std::is_enum<Item>::value || std::is_pointer<Item>::value>{};
+
+template<typename Item>
+class pyReduce{
+#ifdef PYLIST_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static Item _sum_avx2(const Item * first, const long n, const Item total){ return pySimdKernel<Item, 32>::sum(first, n, total); }
+    __attribute__((target("avx2"))) static Item _max_avx2(const Item * first, const long n, const Item maximum){ return pySimdKernel<Item, 32>::max(first, n, maximum); }
+    __attribute__((target("avx2"))) static Item _min_avx2(const Item * first, const long n, const Item minimum){ return pySimdKernel<Item, 32>::min(first, n, minimum); }
+    __attribute__((target("avx2"))) static long _count_avx2(const Item * first, const long n, const Item key){ return pySimdKernel<Item, 32>::count(first, n, key); }
+    __attribute__((target("avx2"))) static long _find_avx2(const Item * first, const long n, const Item key){ return pySimdKernel<Item, 32>::find(first, n, key); }
+    __attribute__((target("avx2"))) static long _mismatch_avx2(const Item * a, const Item * b, const long n){ return pySimdKernel<Item, 32>::mismatch(a, b, n); }
+#endif
+
+public:
+#ifdef __GNUC__
+    static constexpr bool vectorized = (std::is_integral<Item>::value && !std::is_same<Item, bool>::value) ||
+                                       std::is_same<Item, float>::value || std::is_same<Item, double>::value;
+#else
+    static constexpr bool vectorized = false;
+#endif
+
+    static Item sum(const Item *, const long, Item);
+    static Item max(const Item *, const long, Item);
+    static Item min(const Item *, const long, Item);
+    static long count(const Item *, const long, const Item &);
+    static long find(const Item *, const long, const Item &);
+    static long mismatch(const Item *, const Item *, const long);
+    static bool equal(const Item *, const Item *, const long);
+};
+
+template<typename Item>
+Item pyReduce<Item>::sum(const Item * first, const long n, Item total){
+    if constexpr(vectorized){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _sum_avx2(first, n, total);
+        }
+#endif
+        return pySimdKernel<Item, 16>::sum(first, n, total);
+    }
+    else{
+        for(long i=0; i<n; i++){
+            total = total + first[i];
+        }
+        return total;
     }
-    throw std::invalid_argument("Value not in list");
 }
 
-template<typename Type>
-void pyList<Type>::insert(const long index, const Type key){
-    _resize_if_necessary();
-    long act_index = _transform_index(_clamp(index,-length-1,length));
-    if(_len_between(act_index, Tail) < length/2){
-        Tail = _next_index(Tail);
-        long i = Tail;
-        while(i != act_index){
-            long prev_index = _prev_index(i);
-            Array[i] = Array[prev_index];
-            i = prev_index;
+template<typename Item>
+Item pyReduce<Item>::max(const Item * first, const long n, Item maximum){
+    if constexpr(vectorized){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _max_avx2(first, n, maximum);
         }
-        Array[act_index] = key;
-        ++length;
+#endif
+        return pySimdKernel<Item, 16>::max(first, n, maximum);
     }
     else{
-        long i = Head;
-        Head = _prev_index(Head);
-        while(i != _prev_index(act_index)){
-            long next_index = _next_index(i);
-            Array[i] = Array[next_index];
-            i = next_index;
+        for(long i=0; i<n; i++){
+            if(first[i] > maximum){
+                maximum = first[i];
+            }
         }
-        Array[i] = key;
-        ++length;
+        return maximum;
+    }
+}
+
+template<typename Item>
+Item pyReduce<Item>::min(const Item * first, const long n, Item minimum){
+    if constexpr(vectorized){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _min_avx2(first, n, minimum);
+        }
+#endif
+        return pySimdKernel<Item, 16>::min(first, n, minimum);
+    }
+    else{
+        for(long i=0; i<n; i++){
+            if(first[i] < minimum){
+                minimum = first[i];
+            }
+        }
+        return minimum;
+    }
+}
+
+template<typename Item>
+long pyReduce<Item>::count(const Item * first, const long n, const Item & key){
+    if constexpr(vectorized){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _count_avx2(first, n, key);
+        }
+#endif
+        return pySimdKernel<Item, 16>::count(first, n, key);
     }
+    else{
+        long ctr = 0;
+        for(long i=0; i<n; i++){
+            if(first[i] == key){
+                ctr++;
+            }
+        }
+        return ctr;
+    }
+}
+
+template<typename Item>
+long pyReduce<Item>::find(const Item * first, const long n, const Item & key){
+    if constexpr(vectorized){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _find_avx2(first, n, key);
+        }
+#endif
+        return pySimdKernel<Item, 16>::find(first, n, key);
+    }
+    else{
+        for(long i=0; i<n; i++){
+            if(first[i] == key){
+                return i;
+            }
+        }
+        return n;
+    }
+}
+
+template<typename Item>
+long pyReduce<Item>::mismatch(const Item * a, const Item * b, const long n){
+    if constexpr(vectorized && std::is_integral<Item>::value){
+#ifdef PYLIST_AVX2_DISPATCH
+        if(pyHasAvx2()){
+            return _mismatch_avx2(a, b, n);
+        }
+#endif
+        return pySimdKernel<Item, 16>::mismatch(a, b, n);
+    }
+    else{
+        for(long i=0; i<n; i++){
+            if(a[i] > b[i] || a[i] < b[i]){
+                return i;
+            }
+        }
+        return n;
+    }
+}
+
+template<typename Item>
+bool pyReduce<Item>::equal(const Item * a, const Item * b, const long n){
+    if constexpr(pyBitwiseComparable<Item>::value){
+        return n == 0 || std::memcmp(a, b, n * sizeof(Item)) == 0;
+    }
+    else{
+        for(long i=0; i<n; i++){
+            if(a[i] != b[i]){
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+struct pyParallelPolicy{};
+
+inline constexpr pyParallelPolicy py_par{};
+
+struct pyDefaultPolicy{
+    static constexpr bool power_of_two = false;
+    static constexpr float growth_factor = 2;
+    static constexpr float shrink_below = 0.25;
+    static constexpr size_t min_capacity = 8;
+    static constexpr bool copy_on_write = false;
+};
+
+struct pyPowerOfTwoPolicy : pyDefaultPolicy{
+    static constexpr bool power_of_two = true;
+};
+
+struct pyNoShrinkPolicy : pyDefaultPolicy{
+    static constexpr float shrink_below = 0;
+};
+
+struct pyCopyOnWritePolicy : pyDefaultPolicy{
+    static constexpr bool copy_on_write = true;
+};
+
+template<size_t Bytes>
+struct pyInlineStorage{
+    alignas(std::max_align_t) unsigned char Inline[Bytes];
+    void * _inline_buffer(){ return Inline; }
+};
+
+template<>
+struct pyInlineStorage<0>{
+    void * _inline_buffer(){ return nullptr; }
+};
+
+inline long pySliceBounds(const long length, long start, long stop, const long step, long & first){
+    if(step == 0){
+        throw std::invalid_argument("step cannot be zero");
+    }
+    if(start < 0){
+        start = start + length < 0 ? (step < 0 ? -1 : 0) : start + length;
+    }
+    else if(start >= length){
+        start = step < 0 ? length - 1 : length;
+    }
+    if(stop < 0){
+        stop = stop + length < 0 ? (step < 0 ? -1 : 0) : stop + length;
+    }
+    else if(stop >= length){
+        stop = step < 0 ? length - 1 : length;
+    }
+    first = start;
+    if(step < 0){
+        return stop < start ? (start - stop - 1) / (-step) + 1 : 0;
+    }
+    return start < stop ? (stop - start - 1) / step + 1 : 0;
+}
+
+template<typename Type, typename Allocator = std::allocator<Type>, typename Policy = pyDefaultPolicy, size_t InlineBytes = 32>
+class pyList;
+
+template<typename Item>
+class pyRingIterator{
+    Item *Array;
+    long allocated;
+    long origin;
+    long index;
+
+    template<typename>
+    friend class pyRingIterator;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<Item>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Item * pointer;
+    typedef Item & reference;
+
+    pyRingIterator() : Array(nullptr), allocated(0), origin(0), index(0){}
+    pyRingIterator(Item * array, const long size, const long start, const long position) : Array(array), allocated(size), origin(start), index(position){}
+    template<typename Other, typename = typename std::enable_if<std::is_same<const Other, Item>::value && !std::is_same<Other, Item>::value>::type>
+    pyRingIterator(const pyRingIterator<Other> & rhs) : Array(rhs.Array), allocated(rhs.allocated), origin(rhs.origin), index(rhs.index){}
+    reference operator * () const { long position = origin + index; return Array[position < allocated ? position : position - allocated]; }
+    pointer operator -> () const { return &**this; }
+    reference operator [] (const difference_type n) const { return *(*this + n); }
+    pyRingIterator & operator ++ (){ ++index; return *this; }
+    pyRingIterator operator ++ (int){ pyRingIterator old = *this; ++index; return old; }
+    pyRingIterator & operator -- (){ --index; return *this; }
+    pyRingIterator operator -- (int){ pyRingIterator old = *this; --index; return old; }
+    pyRingIterator & operator += (const difference_type n){ index += n; return *this; }
+    pyRingIterator & operator -= (const difference_type n){ index -= n; return *this; }
+    pyRingIterator operator + (const difference_type n) const { return pyRingIterator(Array, allocated, origin, index + n); }
+    pyRingIterator operator - (const difference_type n) const { return pyRingIterator(Array, allocated, origin, index - n); }
+    friend pyRingIterator operator + (const difference_type n, const pyRingIterator & it){ return it + n; }
+    template<typename Other>
+    difference_type operator - (const pyRingIterator<Other> & rhs) const { return index - rhs.index; }
+    template<typename Other>
+    bool operator == (const pyRingIterator<Other> & rhs) const { return index == rhs.index; }
+    template<typename Other>
+    bool operator != (const pyRingIterator<Other> & rhs) const { return index != rhs.index; }
+    template<typename Other>
+    bool operator < (const pyRingIterator<Other> & rhs) const { return index < rhs.index; }
+    template<typename Other>
+    bool operator > (const pyRingIterator<Other> & rhs) const { return index > rhs.index; }
+    template<typename Other>
+    bool operator <= (const pyRingIterator<Other> & rhs) const { return index <= rhs.index; }
+    template<typename Other>
+    bool operator >= (const pyRingIterator<Other> & rhs) const { return index >= rhs.index; }
+};
+
+template<typename Item>
+struct pySegment{
+    Item *first;
+    long length;
+
+    Item * begin() const { return first; }
+    Item * end() const { return first + length; }
+    long len() const { return length; }
+};
+
+template<typename Type>
+class pyListView{
+    const Type *Array;
+    long allocated;
+    long origin;
+    long step;
+    long length;
+    std::shared_ptr<const void> owner;
+
+    template<typename, typename, typename, size_t>
+    friend class pyList;
+    template<typename>
+    friend class pyMappedList;
+
+    pyListView(const Type *, const long, const long, const long, const long, const std::shared_ptr<const void> & = std::shared_ptr<const void>());
+    inline long _position(const long) const;
+    inline const Type * _span(const long, long &) const;
+
+public:
+    class const_iterator{
+        const pyListView<Type> *view;
+        long index;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Type * pointer;
+        typedef const Type & reference;
+
+        const_iterator() : view(nullptr), index(0){}
+        const_iterator(const pyListView<Type> * source, const long position) : view(source), index(position){}
+        reference operator * () const { return (*view)[index]; }
+        pointer operator -> () const { return &(*view)[index]; }
+        reference operator [] (const difference_type n) const { return (*view)[index + n]; }
+        const_iterator & operator ++ (){ ++index; return *this; }
+        const_iterator operator ++ (int){ const_iterator old = *this; ++index; return old; }
+        const_iterator & operator -- (){ --index; return *this; }
+        const_iterator operator -- (int){ const_iterator old = *this; --index; return old; }
+        const_iterator & operator += (const difference_type n){ index += n; return *this; }
+        const_iterator & operator -= (const difference_type n){ index -= n; return *this; }
+        const_iterator operator + (const difference_type n) const { return const_iterator(view, index + n); }
+        const_iterator operator - (const difference_type n) const { return const_iterator(view, index - n); }
+        friend const_iterator operator + (const difference_type n, const const_iterator & it){ return it + n; }
+        difference_type operator - (const const_iterator & rhs) const { return index - rhs.index; }
+        bool operator == (const const_iterator & rhs) const { return index == rhs.index; }
+        bool operator != (const const_iterator & rhs) const { return index != rhs.index; }
+        bool operator < (const const_iterator & rhs) const { return index < rhs.index; }
+        bool operator > (const const_iterator & rhs) const { return index > rhs.index; }
+        bool operator <= (const const_iterator & rhs) const { return index <= rhs.index; }
+        bool operator >= (const const_iterator & rhs) const { return index >= rhs.index; }
+    };
+
+    pyListView();
+    const Type & operator [] (const long) const;
+    pyListView<Type> operator () (const long = 0, const long = LONG_MAX, const long = 1) const;
+    inline long len() const { return length; }
+    const Type & get(const long) const;
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, length); }
+    long count(const Type &) const;
+    long index(const Type &) const;
+    Type max() const;
+    Type min() const;
+    Type sum() const;
+};
+
+template<typename Type>
+pyListView<Type>::pyListView() : Array(nullptr), allocated(0), origin(0), step(1), length(0){}
+
+template<typename Type>
+pyListView<Type>::pyListView(const Type * array, const long size, const long start, const long stride, const long n, const std::shared_ptr<const void> & source)
+    : Array(array), allocated(size), origin(start), step(stride), length(n), owner(source){}
+
+template<typename Type>
+inline long pyListView<Type>::_position(const long index) const{
+    long position = (origin + index * step) % allocated;
+    return position < 0 ? position + allocated : position;
+}
+
+template<typename Type>
+inline const Type * pyListView<Type>::_span(const long index, long & run) const{
+    long position = _position(index);
+    run = step == 1 ? std::min(length - index, allocated - position) : 1;
+    return Array + position;
+}
+
+template<typename Type>
+const Type & pyListView<Type>::operator [] (const long index) const {
+    return Array[_position(index >= 0 ? index : index + length)];
+}
+
+template<typename Type>
+const Type & pyListView<Type>::get(const long index) const {
+    if(index < length && index >= -length){
+        return (*this)[index];
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type>
+pyListView<Type> pyListView<Type>::operator () (const long start, const long stop, const long stride) const {
+    long first;
+    long n = pySliceBounds(length, start, stop, stride, first);
+    if(n == 0){
+        return pyListView<Type>();
+    }
+    return pyListView<Type>(Array, allocated, _position(first), step * stride, n, owner);
+}
+
+template<typename Type>
+long pyListView<Type>::count(const Type & key) const{
+    long ctr = 0;
+    long i = 0;
+    while(i < length){
+        long run;
+        const Type *first = _span(i, run);
+        ctr += pyReduce<Type>::count(first, run, key);
+        i += run;
+    }
+    return ctr;
+}
+
+template<typename Type>
+long pyListView<Type>::index(const Type & key) const{
+    long i = 0;
+    while(i < length){
+        long run;
+        const Type *first = _span(i, run);
+        long k = pyReduce<Type>::find(first, run, key);
+        if(k < run){
+            return i + k;
+        }
+        i += run;
+    }
+    throw std::invalid_argument("Value not in list");
+}
+
+template<typename Type>
+Type pyListView<Type>::max() const{
+    if(length == 0){
+        throw std::domain_error("max of empty list");
+    }
+    Type maximum = (*this)[0];
+    long i = 1;
+    while(i < length){
+        long run;
+        const Type *first = _span(i, run);
+        maximum = pyReduce<Type>::max(first, run, maximum);
+        i += run;
+    }
+    return maximum;
+}
+
+template<typename Type>
+Type pyListView<Type>::min() const{
+    if(length == 0){
+        throw std::domain_error("min of empty list");
+    }
+    Type minimum = (*this)[0];
+    long i = 1;
+    while(i < length){
+        long run;
+        const Type *first = _span(i, run);
+        minimum = pyReduce<Type>::min(first, run, minimum);
+        i += run;
+    }
+    return minimum;
+}
+
+template<typename Type>
+Type pyListView<Type>::sum() const{
+    Type total = 0;
+    long i = 0;
+    while(i < length){
+        long run;
+        const Type *first = _span(i, run);
+        total = pyReduce<Type>::sum(first, run, total);
+        i += run;
+    }
+    return total;
+}
+
+template<typename Type>
+std::ostream & operator << (std::ostream & o, const pyListView<Type> & View){
+    o << "[";
+    long n = View.len();
+    for(long i=0; i < n; i++){
+        if(i == 0){ o << View[i]; }
+        else{ o << ", " << View[i]; }
+    }
+    return o << "]";
+}
+
+template<typename Type>
+struct pyListTraits{
+    static constexpr bool nested = false;
+    typedef Type element_type;
+};
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+struct pyListTraits<pyList<Type, Allocator, Policy, InlineBytes>>{
+    static constexpr bool nested = true;
+    typedef Type element_type;
+};
+
+template<typename Item>
+struct pyTypeTag{
+    static constexpr uint32_t value = std::is_same<Item, bool>::value ? 'b' : std::is_floating_point<Item>::value ? 'f' : std::is_integral<Item>::value ? (std::is_signed<Item>::value ? 'i' : 'u') : 'o';
+};
+
+inline const char * pySkipSpace(const char * first, const char * last){
+    while(first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r')){
+        ++first;
+    }
+    return first;
+}
+
+template<typename Item>
+struct pyRepr{
+    static constexpr size_t WIDTH = 32;
+    static char * format(char *, const Item &);
+    static void write(std::string &, const Item &);
+    static const char * read(const char *, const char *, Item &);
+};
+
+template<typename Item>
+char * pyRepr<Item>::format(char * out, const Item & item){
+    if constexpr(std::is_same<Item, bool>::value){
+        return item ? std::copy_n("True", 4, out) : std::copy_n("False", 5, out);
+    }
+    else if constexpr(std::is_floating_point<Item>::value){
+        if(std::isnan(item)){
+            return std::copy_n("nan", 3, out);
+        }
+        if(std::isinf(item)){
+            return item < 0 ? std::copy_n("-inf", 4, out) : std::copy_n("inf", 3, out);
+        }
+        char digits[WIDTH];
+        char *end = std::to_chars(digits, digits + WIDTH, item, std::chars_format::scientific).ptr;
+        char *mark = std::find(digits, end, 'e');
+        int exponent = 0;
+        std::from_chars(mark + (mark[1] == '+' ? 2 : 1), end, exponent);
+        if(exponent < -4 || exponent >= 16){
+            return std::copy(digits, end, out);
+        }
+        char *mantissa = digits;
+        if(*mantissa == '-'){
+            *out++ = '-';
+            ++mantissa;
+        }
+        char significant[WIDTH];
+        int n = 0;
+        for(; mantissa != mark; ++mantissa){
+            if(*mantissa != '.'){
+                significant[n++] = *mantissa;
+            }
+        }
+        if(exponent >= 0){
+            int whole = exponent + 1;
+            if(n <= whole){
+                out = std::copy_n(significant, n, out);
+                out = std::fill_n(out, whole - n, '0');
+                return std::copy_n(".0", 2, out);
+            }
+            out = std::copy_n(significant, whole, out);
+            *out++ = '.';
+            return std::copy_n(significant + whole, n - whole, out);
+        }
+        out = std::copy_n("0.", 2, out);
+        out = std::fill_n(out, -exponent - 1, '0');
+        return std::copy_n(significant, n, out);
+    }
+    else{
+        return std::to_chars(out, out + WIDTH, item).ptr;
+    }
+}
+
+template<typename Item>
+void pyRepr<Item>::write(std::string & out, const Item & item){
+    if constexpr(std::is_arithmetic<Item>::value){
+        char digits[WIDTH];
+        out.append(digits, format(digits, item));
+    }
+    else if constexpr(std::is_same<Item, std::string>::value){
+        char quote = item.find('\'') != std::string::npos && item.find('"') == std::string::npos ? '"' : '\'';
+        out += quote;
+        for(char c:item){
+            switch(c){
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if(c == quote){
+                        out += '\\';
+                        out += c;
+                    }
+                    else if((unsigned char)c < 0x20 || c == 0x7f){
+                        const char *hex = "0123456789abcdef";
+                        out += "\\x";
+                        out += hex[(unsigned char)c >> 4];
+                        out += hex[c & 15];
+                    }
+                    else{
+                        out += c;
+                    }
+            }
+        }
+        out += quote;
+    }
+    else{
+        std::ostringstream text;
+        text << item;
+        out += text.str();
+    }
+}
+
+template<typename Item>
+const char * pyRepr<Item>::read(const char * first, const char * last, Item & item){
+    if constexpr(std::is_same<Item, bool>::value){
+        if(last - first >= 4 && std::memcmp(first, "True", 4) == 0){
+            item = true;
+            return first + 4;
+        }
+        if(last - first >= 5 && std::memcmp(first, "False", 5) == 0){
+            item = false;
+            return first + 5;
+        }
+        throw std::invalid_argument("ValueError: malformed list repr");
+    }
+    else if constexpr(std::is_arithmetic<Item>::value){
+        std::from_chars_result result = std::from_chars(first, last, item);
+        if(result.ec == std::errc::result_out_of_range){
+            throw std::invalid_argument("ValueError: value out of range in list repr");
+        }
+        if(result.ec != std::errc()){
+            throw std::invalid_argument("ValueError: malformed list repr");
+        }
+        return result.ptr;
+    }
+    else if constexpr(std::is_same<Item, std::string>::value){
+        if(first == last || (*first != '\'' && *first != '"')){
+            throw std::invalid_argument("ValueError: malformed list repr");
+        }
+        char quote = *first++;
+        item.clear();
+        while(first != last && *first != quote){
+            char c = *first++;
+            if(c == '\\'){
+                if(first == last){
+                    break;
+                }
+                c = *first++;
+                switch(c){
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'x':{
+                        unsigned value = 0;
+                        if(last - first < 2 || std::from_chars(first, first + 2, value, 16).ptr != first + 2){
+                            throw std::invalid_argument("ValueError: malformed list repr");
+                        }
+                        first += 2;
+                        c = (char)value;
+                        break;
+                    }
+                    default: break;
+                }
+            }
+            item += c;
+        }
+        if(first == last){
+            throw std::invalid_argument("ValueError: malformed list repr");
+        }
+        return first + 1;
+    }
+    else{
+        static_assert(std::is_arithmetic<Item>::value || std::is_same<Item, std::string>::value, "parse supports numeric, bool, std::string and nested pyList elements");
+        return first;
+    }
+}
+
+inline void pySwapBytes(void * data, const size_t size, const size_t n){
+    unsigned char *bytes = static_cast<unsigned char *>(data);
+    for(size_t i=0; i<n; i++){
+        std::reverse(bytes + i*size, bytes + (i + 1)*size);
+    }
+}
+
+struct pyListHeader{
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ENDIAN_MARK = 0x01020304;
+    static constexpr uint64_t ALIGNMENT = 64;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t type_tag;
+    uint32_t element_size;
+    uint32_t nested;
+    uint32_t reserved;
+    uint64_t length;
+    uint64_t data_offset;
+    uint64_t data_length;
+    unsigned char padding[8];
+
+    static pyListHeader make(const uint32_t, const uint32_t, const bool, const uint64_t, const uint64_t);
+    bool validate(const uint32_t, const uint32_t, const bool);
+    void check_size(const uint64_t, const uint64_t) const;
+};
+
+static_assert(sizeof(pyListHeader) == 64, "pyListHeader must stay 64 bytes");
+
+pyListHeader pyListHeader::make(const uint32_t tag, const uint32_t size, const bool is_nested, const uint64_t n, const uint64_t total){
+    pyListHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "PYLIST\0", 8);
+    header.version = VERSION;
+    header.byte_order = ENDIAN_MARK;
+    header.type_tag = tag;
+    header.element_size = size;
+    header.nested = is_nested;
+    header.length = n;
+    uint64_t offset = sizeof(pyListHeader) + (is_nested ? (n + 1)*sizeof(uint64_t) : 0);
+    header.data_offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    header.data_length = total;
+    return header;
+}
+
+bool pyListHeader::validate(const uint32_t tag, const uint32_t size, const bool is_nested){
+    if(std::memcmp(magic, "PYLIST\0", 8) != 0){
+        throw std::invalid_argument("not a pyList file");
+    }
+    bool swapped = byte_order != ENDIAN_MARK;
+    if(swapped){
+        pySwapBytes(&byte_order, sizeof(uint32_t), 1);
+        if(byte_order != ENDIAN_MARK){
+            throw std::invalid_argument("not a pyList file");
+        }
+        pySwapBytes(&version, sizeof(uint32_t), 1);
+        pySwapBytes(&type_tag, sizeof(uint32_t), 1);
+        pySwapBytes(&element_size, sizeof(uint32_t), 1);
+        pySwapBytes(&nested, sizeof(uint32_t), 1);
+        pySwapBytes(&length, sizeof(uint64_t), 3);
+    }
+    if(version != VERSION){
+        throw std::invalid_argument("unsupported pyList file version " + std::to_string(version));
+    }
+    if(type_tag != tag || element_size != size || nested != (uint32_t)is_nested){
+        throw std::invalid_argument("pyList file element type mismatch");
+    }
+    if(swapped && tag == 'o'){
+        throw std::invalid_argument("cannot byte-swap opaque pyList elements");
+    }
+    if(!is_nested && data_length != length){
+        throw std::invalid_argument("corrupt pyList file");
+    }
+    return swapped;
+}
+
+void pyListHeader::check_size(const uint64_t size, const uint64_t alignment) const {
+    uint64_t items = nested ? data_length : length;
+    if(data_offset > size || items > (size - data_offset) / element_size ||
+       (nested && length >= (size - sizeof(pyListHeader)) / sizeof(uint64_t))){
+        throw std::invalid_argument("truncated pyList file");
+    }
+    uint64_t table = sizeof(pyListHeader) + (nested ? (length + 1)*sizeof(uint64_t) : 0);
+    if(data_offset < table || data_offset % alignment != 0){
+        throw std::invalid_argument("corrupt pyList file");
+    }
+}
+
+class pyMapping{
+    const unsigned char *data;
+    size_t size;
+
+public:
+    explicit pyMapping(const std::string &);
+    pyMapping(const pyMapping &) = delete;
+    pyMapping & operator = (const pyMapping &) = delete;
+    ~pyMapping();
+    const unsigned char * bytes() const { return data; }
+    size_t len() const { return size; }
+};
+
+pyMapping::pyMapping(const std::string & path) : data(nullptr), size(0){
+#ifdef PYLIST_POSIX_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        throw std::runtime_error("cannot open " + path);
+    }
+    struct stat info;
+    if(::fstat(fd, &info) != 0){
+        ::close(fd);
+        throw std::runtime_error("cannot stat " + path);
+    }
+    size = info.st_size;
+    if(size > 0){
+        void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if(mapped == MAP_FAILED){
+            ::close(fd);
+            throw std::runtime_error("cannot map " + path);
+        }
+        data = static_cast<const unsigned char *>(mapped);
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if(!in){
+        throw std::runtime_error("cannot open " + path);
+    }
+    size = in.tellg();
+    unsigned char *buffer = static_cast<unsigned char *>(::operator new(size + 1, std::align_val_t(pyListHeader::ALIGNMENT)));
+    in.seekg(0);
+    if(!in.read(reinterpret_cast<char *>(buffer), size)){
+        ::operator delete(buffer, std::align_val_t(pyListHeader::ALIGNMENT));
+        throw std::runtime_error("cannot read " + path);
+    }
+    data = buffer;
+#endif
+}
+
+pyMapping::~pyMapping(){
+#ifdef PYLIST_POSIX_MMAP
+    if(data != nullptr){
+        ::munmap(const_cast<unsigned char *>(data), size);
+    }
+#else
+    ::operator delete(const_cast<unsigned char *>(data), std::align_val_t(pyListHeader::ALIGNMENT));
+#endif
+}
+
+template<typename Type>
+class pyMappedList : public pyListView<Type>{
+    static_assert(std::is_trivially_copyable<Type>::value, "mmap requires trivially copyable elements");
+
+public:
+    explicit pyMappedList(const std::string &);
+};
+
+template<typename Type>
+pyMappedList<Type>::pyMappedList(const std::string & path){
+    std::shared_ptr<const pyMapping> mapping = std::make_shared<const pyMapping>(path);
+    pyListHeader header;
+    if(mapping->len() < sizeof(header)){
+        throw std::invalid_argument("not a pyList file");
+    }
+    std::memcpy(&header, mapping->bytes(), sizeof(header));
+    if(header.validate(pyTypeTag<Type>::value, sizeof(Type), false)){
+        throw std::invalid_argument("pyList file has foreign byte order, use load()");
+    }
+    header.check_size(mapping->len(), alignof(Type));
+    this->Array = reinterpret_cast<const Type *>(mapping->bytes() + header.data_offset);
+    this->allocated = header.length;
+    this->length = header.length;
+    this->owner = mapping;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+class pyMappedList<pyList<Type, Allocator, Policy, InlineBytes>>{
+    static_assert(std::is_trivially_copyable<Type>::value, "mmap requires trivially copyable elements");
+
+    std::shared_ptr<const pyMapping> mapping;
+    const uint64_t *offsets;
+    const Type *Array;
+    long length;
+
+public:
+    explicit pyMappedList(const std::string &);
+    pyListView<Type> operator [] (const long) const;
+    pyListView<Type> get(const long) const;
+    inline long len() const { return length; }
+};
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyMappedList<pyList<Type, Allocator, Policy, InlineBytes>>::pyMappedList(const std::string & path) : mapping(std::make_shared<const pyMapping>(path)){
+    pyListHeader header;
+    if(mapping->len() < sizeof(header)){
+        throw std::invalid_argument("not a pyList file");
+    }
+    std::memcpy(&header, mapping->bytes(), sizeof(header));
+    if(header.validate(pyTypeTag<Type>::value, sizeof(Type), true)){
+        throw std::invalid_argument("pyList file has foreign byte order, use load()");
+    }
+    header.check_size(mapping->len(), alignof(Type));
+    offsets = reinterpret_cast<const uint64_t *>(mapping->bytes() + sizeof(header));
+    Array = reinterpret_cast<const Type *>(mapping->bytes() + header.data_offset);
+    length = header.length;
+    for(long i=0; i<length; i++){
+        if(offsets[i] > offsets[i + 1]){
+            throw std::invalid_argument("corrupt pyList file");
+        }
+    }
+    if(offsets[0] != 0 || offsets[length] != header.data_length){
+        throw std::invalid_argument("corrupt pyList file");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyListView<Type> pyMappedList<pyList<Type, Allocator, Policy, InlineBytes>>::operator [] (const long index) const {
+    long row = index >= 0 ? index : index + length;
+    long n = offsets[row + 1] - offsets[row];
+    if(n == 0){
+        return pyListView<Type>();
+    }
+    return pyListView<Type>(Array + offsets[row], n, 0, 1, n, mapping);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyListView<Type> pyMappedList<pyList<Type, Allocator, Policy, InlineBytes>>::get(const long index) const {
+    if(index < length && index >= -length){
+        return (*this)[index];
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::ostream & operator << (std::ostream & o, const pyMappedList<pyList<Type, Allocator, Policy, InlineBytes>> & List){
+    o << "[";
+    long n = List.len();
+    for(long i=0; i < n; i++){
+        if(i == 0){ o << List[i]; }
+        else{ o << ", " << List[i]; }
+    }
+    return o << "]";
+}
+
+template<typename List, typename Derived>
+class pyListExpr;
+
+template<typename List>
+class pyListLeaf;
+
+template<typename List, typename Left, typename Right>
+class pyConcatExpr;
+
+template<typename List, typename Operand>
+class pyRepeatExpr;
+
+template<typename List, typename Derived>
+class pyListExpr{
+public:
+    const Derived & self() const { return static_cast<const Derived &>(*this); }
+    template<typename Other>
+    pyConcatExpr<List, Derived, Other> operator + (const pyListExpr<List, Other> & rhs) const { return pyConcatExpr<List, Derived, Other>(self(), rhs.self()); }
+    pyConcatExpr<List, Derived, pyListLeaf<List>> operator + (const List & rhs) const { return pyConcatExpr<List, Derived, pyListLeaf<List>>(self(), pyListLeaf<List>(rhs)); }
+    pyRepeatExpr<List, Derived> operator * (const long rhs) const { return pyRepeatExpr<List, Derived>(self(), rhs); }
+    bool operator == (const List & rhs) const { return List(*this) == rhs; }
+    bool operator != (const List & rhs) const { return List(*this) != rhs; }
+    auto operator [] (const long index) const { return List(*this)[index]; }
+    List operator () (const long start = 0, const long stop = LONG_MAX, const long step = 1) const { return List(*this)(start, stop, step); }
+    List slice(const long start = 0, const long stop = LONG_MAX, const long step = 1) const { return List(*this)(start, stop, step); }
+};
+
+template<typename List>
+class pyListLeaf : public pyListExpr<List, pyListLeaf<List>>{
+    const List & list;
+    long length;
+
+public:
+    explicit pyListLeaf(const List & source):list(source), length(source.len()){}
+    long len() const { return length; }
+    auto get_allocator() const { return list.get_allocator(); }
+    void _write(List & dest) const { dest._append_from(list, length); }
+};
+
+template<typename List, typename Left, typename Right>
+class pyConcatExpr : public pyListExpr<List, pyConcatExpr<List, Left, Right>>{
+    Left left;
+    Right right;
+
+public:
+    pyConcatExpr(const Left & lhs, const Right & rhs):left(lhs), right(rhs){}
+    long len() const { return left.len() + right.len(); }
+    auto get_allocator() const { return left.get_allocator(); }
+    void _write(List & dest) const {
+        left._write(dest);
+        right._write(dest);
+    }
+};
+
+template<typename List, typename Operand>
+class pyRepeatExpr : public pyListExpr<List, pyRepeatExpr<List, Operand>>{
+    Operand operand;
+    long times;
+
+public:
+    pyRepeatExpr(const Operand & source, const long n):operand(source), times(n > 0 ? n : 0){}
+    long len() const { return times*operand.len(); }
+    auto get_allocator() const { return operand.get_allocator(); }
+    void _write(List & dest) const {
+        long total = len();
+        if(total == 0){
+            return;
+        }
+        long start = dest.len();
+        operand._write(dest);
+        long written = dest.len() - start;
+        while(written < total){
+            long chunk = written < total - written ? written : total - written;
+            dest._append_from(dest, chunk, start);
+            written += chunk;
+        }
+    }
+};
+
+template<typename List, typename Derived>
+pyRepeatExpr<List, Derived> operator * (const long lhs, const pyListExpr<List, Derived> & rhs){
+    return rhs * lhs;
+}
+
+template<typename List, typename Derived>
+std::ostream & operator << (std::ostream & o, const pyListExpr<List, Derived> & Expr){
+    return o << List(Expr);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+class pyList : private pyInlineStorage<InlineBytes>{
+    static constexpr size_t INITIAL_ARRAY_SIZE = Policy::min_capacity;
+    static constexpr float RESIZE_FACTOR = Policy::growth_factor;
+    static constexpr float SHRINK_THRESHOLD = Policy::shrink_below;
+    static_assert(RESIZE_FACTOR > 1, "growth_factor must be greater than 1");
+    static_assert(SHRINK_THRESHOLD * RESIZE_FACTOR < 1, "shrink_below must leave a hysteresis band below 1/growth_factor");
+    static constexpr long INSERTION_SORT_THRESHOLD = 24;
+    static constexpr long NINTHER_THRESHOLD = 128;
+    static constexpr long PARTIAL_INSERTION_LIMIT = 8;
+    static constexpr long PARALLEL_SORT_THRESHOLD = 1 << 16;
+    static constexpr long RADIX_SORT_THRESHOLD = 256;
+    static constexpr long REPR_BLOCK = 256;
+
+    long Head;
+    long Tail;
+    size_t allocated;
+    long length;
+    Type *Array;
+    Allocator alloc;
+
+    typedef std::allocator_traits<Allocator> AllocTraits;
+    static_assert(std::is_same<typename AllocTraits::value_type, Type>::value, "Allocator::value_type must be Type");
+
+    template<typename>
+    friend class pyListLeaf;
+    template<typename, typename>
+    friend class pyRepeatExpr;
+    template<typename, typename, typename, size_t>
+    friend class pyList;
+    template<typename, typename, size_t>
+    friend class pyHeap;
+
+    pyList(const size_t, const Allocator &);
+    static constexpr size_t _inline_slots();
+    Type * _inline_data(){ return static_cast<Type *>(this->_inline_buffer()); }
+    bool _is_inline() const { return _inline_slots() > 0 && Array == const_cast<pyList *>(this)->_inline_data(); }
+    void _reset_empty();
+    void _init_storage(const size_t);
+    void _steal(pyList<Type, Allocator, Policy, InlineBytes> &);
+    Type * _allocate(const size_t);
+    void _deallocate(Type *, const size_t);
+    static constexpr size_t _counter_slots();
+    static std::atomic<long> * _counter(Type *, const size_t);
+    bool _is_shared() const;
+    void _detach();
+    void _release();
+    template<typename... Args>
+    void _construct(Type *, Args &&...);
+    void _destroy(Type *);
+    static void _copy_n(const Type *, const long, Type *);
+    static void _transfer_n(Type *, const long, Type *);
+    void _destroy_elements();
+    void _reallocate(const size_t);
+    void _grow_for(const long);
+    void _shrink_if_necessary();
+    void _open(const long, const long);
+    void _erase(const long, const long, const long);
+    void _append_from(const pyList<Type, Allocator, Policy, InlineBytes> &, const long, const long = 0);
+    void _swap(pyList<Type, Allocator, Policy, InlineBytes> &);
+    size_t _round_capacity(const size_t) const;
+    size_t _capacity(const size_t) const;
+    inline long _wrap(const long index) const { return Policy::power_of_two ? (index & (allocated - 1)) : (index % allocated); }
+    inline long _next_index(const long index) const { return _wrap(index + 1); }
+    inline long _prev_index(const long index) const { return _wrap(index + allocated - 1); }
+    inline long _transform_index(const long) const;
+    inline long _untransform_index(const long) const;
+    inline long _first_segment() const { return std::min(length, (long)allocated - _next_index(Head)); }
+    inline const Type * _span(const long, long &) const;
+    inline long _origin() const { return allocated > 0 ? _next_index(Head) : 0; }
+    long _clamp(const long, const long, const long) const;
+    long _len_between(const long , const long) const;
+    void _linearize();
+    static void _sort2(Type *, Type *);
+    static void _sort3(Type *, Type *, Type *);
+    static void _insertion_sort(Type *, Type *);
+    static bool _partial_insertion_sort(Type *, Type *);
+    static void _sift_down(Type *, const long, long);
+    static void _heapsort(Type *, Type *);
+    static Type * _partition_left(Type *, Type *);
+    static Type * _partition_right(Type *, Type *, bool &);
+    static void _introsort(Type *, Type *, int, bool);
+    void _testsort() const;
+    void _resize_if_necessary();
+    void _read_items(std::istream &, const long, const bool);
+    const char * _read_repr(const char *, const char *);
+
+public:
+    typedef pyRingIterator<Type> iterator;
+    typedef pyRingIterator<const Type> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    pyList();
+    explicit pyList(const Allocator &);
+    pyList(const pyList<Type, Allocator, Policy, InlineBytes> & );
+    pyList(const std::initializer_list<Type>, const Allocator & = Allocator());
+    pyList(const pyListView<Type> &, const Allocator & = Allocator());
+    template<typename Derived>
+    pyList(const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> &);
+    pyList(pyList<Type, Allocator, Policy, InlineBytes> && );
+    ~pyList();
+    pyList<Type, Allocator, Policy, InlineBytes> & operator = (pyList<Type, Allocator, Policy, InlineBytes>);
+    pyList<Type, Allocator, Policy, InlineBytes> & operator = (const pyListView<Type> &);
+    template<typename Derived>
+    pyList<Type, Allocator, Policy, InlineBytes> & operator = (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> &);
+    Type & operator [] (const long);
+    const Type & operator [] (const long) const;
+    pyListView<Type> operator () (const long = 0, const long = LONG_MAX, const long = 1) const &;
+    pyList<Type, Allocator, Policy, InlineBytes> operator () (const long = 0, const long = LONG_MAX, const long = 1) &&;
+    pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>> operator + (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    template<typename Derived>
+    pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, Derived> operator + (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> &) const;
+    void operator += (const pyList<Type, Allocator, Policy, InlineBytes> &);
+    template<typename Derived>
+    void operator += (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> &);
+    pyRepeatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>> operator * (const long) const;
+    void operator *= (const long);
+    bool operator == (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    bool operator != (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    bool operator < (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    bool operator >= (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    bool operator <= (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    bool operator > (const pyList<Type, Allocator, Policy, InlineBytes> &) const;
+    inline long len() const;
+    void reverse();
+    const Type & get(const long) const;
+    void set(const long, const Type &);
+    void set(const long, Type &&);
+    void append(const Type &);
+    void append(Type &&);
+    template<typename... Args>
+    Type & emplace_back(Args &&...);
+    void extend(const pyList<Type, Allocator, Policy, InlineBytes> &);
+    template<typename Derived>
+    void extend(const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> &);
+    pyList<Type, Allocator, Policy, InlineBytes> slice(const long = 0, const long = LONG_MAX, const long = 1) const;
+    void set_slice(const long, const long, const long, const pyList<Type, Allocator, Policy, InlineBytes> &);
+    void del_slice(const long = 0, const long = LONG_MAX, const long = 1);
+    Type pop(const long = -1);
+    void remove(const Type &);
+    void clear();
+    long count(const Type &) const;
+    long index(const Type &, const long = 0, const long = LONG_MAX);
+    Type max();
+    Type min();
+    Type sum();
+    void insert(const long, const Type &);
+    void insert(const long, Type &&);
+    template<typename... Args>
+    Type & emplace(const long, Args &&...);
+    void sort(const bool = false);
+    template<typename Key>
+    void sort(Key, const bool = false);
+    void sort(const pyParallelPolicy &, const bool = false);
+    void sort_unstable();
+    void reserve(const long);
+    long capacity() const;
+    void shrink_to_fit();
+    Allocator get_allocator() const { return alloc; }
+    iterator begin(){ _detach(); return iterator(Array, allocated, _origin(), 0); }
+    iterator end(){ _detach(); return iterator(Array, allocated, _origin(), length); }
+    const_iterator begin() const { return const_iterator(Array, allocated, _origin(), 0); }
+    const_iterator end() const { return const_iterator(Array, allocated, _origin(), length); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin(){ return reverse_iterator(end()); }
+    reverse_iterator rend(){ return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+    std::array<pySegment<Type>, 2> segments();
+    std::array<pySegment<const Type>, 2> segments() const;
+    void save(const std::string &) const;
+    static pyList<Type, Allocator, Policy, InlineBytes> load(const std::string &, const Allocator & = Allocator());
+    static pyMappedList<Type> mmap(const std::string &);
+    std::string to_string() const;
+    void write_repr(std::string &) const;
+    void write_repr(std::ostream &) const;
+    static pyList<Type, Allocator, Policy, InlineBytes> parse(std::string_view, const Allocator & = Allocator());
+};
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList():pyList(Allocator()){
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const Allocator & allocator):alloc(allocator){
+    _reset_empty();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const size_t request_size, const Allocator & allocator):alloc(allocator){
+    _init_storage(request_size);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const pyList<Type, Allocator, Policy, InlineBytes> & rhs):alloc(AllocTraits::select_on_container_copy_construction(rhs.alloc)){
+    if constexpr(Policy::copy_on_write){
+        if(rhs.Array != nullptr && !rhs._is_inline() && alloc == rhs.alloc){
+            _counter(rhs.Array, rhs.allocated)->fetch_add(1, std::memory_order_relaxed);
+            Head = rhs.Head;
+            Tail = rhs.Tail;
+            length = rhs.length;
+            allocated = rhs.allocated;
+            Array = rhs.Array;
+            return;
+        }
+    }
+    _init_storage(std::max<size_t>(RESIZE_FACTOR*rhs.length, rhs.length + 1));
+    try{
+        _append_from(rhs, rhs.length);
+    }
+    catch(...){
+        _destroy_elements();
+        _deallocate(Array, allocated);
+        throw;
+    }
+}
+
+/*template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const std::initializer_list<Type> source):pyList(RESIZE_FACTOR*source.size()){
+    std::cout << "init_list " << source.size() << " " << RESIZE_FACTOR*source.size() << std::endl;
+    for(Type item:source){
+        Array[++Tail] = item;
+    }
+    length = source.size();
+}*/
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const std::initializer_list<Type> source, const Allocator & allocator):alloc(allocator){
+    _init_storage(std::max<size_t>(RESIZE_FACTOR*source.size(), source.size() + 1));
+
+    for(const Type & item:source){
+        _construct(&Array[Tail+1], item);
+        ++Tail;
+        ++length;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const pyListView<Type> & View, const Allocator & allocator):alloc(allocator){
+    long n = View.len();
+    _init_storage(n + 1);
+    try{
+        long i = 0;
+        while(i < n){
+            long run;
+            const Type *first = View._span(i, run);
+            _copy_n(first, run, Array + Tail + 1);
+            Tail += run;
+            length += run;
+            i += run;
+        }
+    }
+    catch(...){
+        _destroy_elements();
+        _deallocate(Array, allocated);
+        throw;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Derived>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> & Expr):alloc(AllocTraits::select_on_container_copy_construction(Expr.self().get_allocator())){
+    _init_storage(Expr.self().len() + 1);
+    try{
+        Expr.self()._write(*this);
+    }
+    catch(...){
+        _destroy_elements();
+        _deallocate(Array, allocated);
+        throw;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::pyList(pyList<Type, Allocator, Policy, InlineBytes> && rhs):alloc(std::move(rhs.alloc)){
+    _reset_empty();
+    _steal(rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes>::~pyList(){
+    _release();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+constexpr size_t pyList<Type, Allocator, Policy, InlineBytes>::_inline_slots(){
+    size_t slots = alignof(Type) <= alignof(std::max_align_t) ? InlineBytes / sizeof(Type) : 0;
+    if(Policy::power_of_two){
+        size_t rounded = 1;
+        while(rounded * 2 <= slots){
+            rounded *= 2;
+        }
+        slots = slots > 0 ? rounded : 0;
+    }
+    return slots >= 2 ? slots : 0;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_reset_empty(){
+    Head = 0;
+    Tail = 0;
+    length = 0;
+    if(_inline_slots() > 0){
+        Array = _inline_data();
+        allocated = _inline_slots();
+    }
+    else{
+        Array = nullptr;
+        allocated = 0;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_init_storage(const size_t request_size){
+    _reset_empty();
+    if(request_size > 1 && request_size > _inline_slots()){
+        allocated = _capacity(request_size);
+        Array = _allocate(allocated);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_steal(pyList<Type, Allocator, Policy, InlineBytes> & rhs){
+    if(rhs._is_inline()){
+        Head = rhs.Head;
+        Tail = rhs.Head;
+        long index = rhs.Head;
+        while(index != rhs.Tail){
+            index = rhs._next_index(index);
+            _construct(&Array[index], std::move(rhs.Array[index]));
+            Tail = index;
+            ++length;
+        }
+        rhs._destroy_elements();
+    }
+    else{
+        Head = rhs.Head;
+        Tail = rhs.Tail;
+        length = rhs.length;
+        allocated = rhs.allocated;
+        Array = rhs.Array;
+    }
+    rhs._reset_empty();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type * pyList<Type, Allocator, Policy, InlineBytes>::_allocate(const size_t size){
+    Type *buffer = AllocTraits::allocate(alloc, size + _counter_slots());
+    if constexpr(Policy::copy_on_write){
+        ::new (static_cast<void *>(_counter(buffer, size))) std::atomic<long>(1);
+    }
+    return buffer;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_deallocate(Type * buffer, const size_t size){
+    if(buffer != nullptr && buffer != _inline_data()){
+        if constexpr(Policy::copy_on_write){
+            _counter(buffer, size)->~atomic();
+        }
+        AllocTraits::deallocate(alloc, buffer, size + _counter_slots());
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+constexpr size_t pyList<Type, Allocator, Policy, InlineBytes>::_counter_slots(){
+    if(!Policy::copy_on_write){
+        return 0;
+    }
+    return (sizeof(std::atomic<long>) + alignof(std::atomic<long>) - 1 + sizeof(Type) - 1) / sizeof(Type);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::atomic<long> * pyList<Type, Allocator, Policy, InlineBytes>::_counter(Type * buffer, const size_t size){
+    uintptr_t end = reinterpret_cast<uintptr_t>(buffer + size);
+    end = (end + alignof(std::atomic<long>) - 1) & ~(uintptr_t)(alignof(std::atomic<long>) - 1);
+    return reinterpret_cast<std::atomic<long> *>(end);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::_is_shared() const {
+    if constexpr(Policy::copy_on_write){
+        return Array != nullptr && !_is_inline() && _counter(Array, allocated)->load(std::memory_order_acquire) > 1;
+    }
+    return false;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_detach(){
+    if constexpr(std::is_copy_constructible<Type>::value){
+        if(!_is_shared()){
+            return;
+        }
+        Type *temp = _allocate(allocated);
+        long start = _next_index(Head);
+        long first = _first_segment();
+        long copied = 0;
+        try{
+            _copy_n(Array + start, first, temp + start);
+            copied = first;
+            _copy_n(Array, length - first, temp);
+        }
+        catch(...){
+            for(long i=0; i<copied; i++){
+                _destroy(temp + start + i);
+            }
+            _deallocate(temp, allocated);
+            throw;
+        }
+        _release();
+        Array = temp;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_release(){
+    if constexpr(Policy::copy_on_write){
+        if(Array != nullptr && !_is_inline() && _counter(Array, allocated)->fetch_sub(1, std::memory_order_acq_rel) > 1){
+            return;
+        }
+    }
+    _destroy_elements();
+    _deallocate(Array, allocated);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename... Args>
+void pyList<Type, Allocator, Policy, InlineBytes>::_construct(Type * slot, Args &&... args){
+    AllocTraits::construct(alloc, slot, std::forward<Args>(args)...);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_destroy(Type * slot){
+    AllocTraits::destroy(alloc, slot);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_copy_n(const Type * source, const long n, Type * dest){
+    if constexpr(std::is_trivially_copyable<Type>::value){
+        if(n > 0){
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(source), n * sizeof(Type));
+        }
+    }
+    else{
+        std::uninitialized_copy(source, source + n, dest);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_transfer_n(Type * source, const long n, Type * dest){
+    if constexpr(std::is_trivially_copyable<Type>::value){
+        if(n > 0){
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(source), n * sizeof(Type));
+        }
+    }
+    else if constexpr(std::is_nothrow_move_constructible<Type>::value || !std::is_copy_constructible<Type>::value){
+        std::uninitialized_move(source, source + n, dest);
+    }
+    else{
+        std::uninitialized_copy(source, source + n, dest);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_destroy_elements(){
+    if constexpr(std::is_trivially_destructible<Type>::value){
+        return;
+    }
+    long index = Head;
+    while(index != Tail){
+        index = _next_index(index);
+        _destroy(&Array[index]);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_reallocate(const size_t newsize){
+    Type *temp;
+    size_t tempsize;
+    if(!_is_inline() && newsize <= _inline_slots()){
+        temp = _inline_data();
+        tempsize = _inline_slots();
+    }
+    else{
+        temp = _allocate(newsize);
+        tempsize = newsize;
+    }
+    if(length > 0){
+        long first = _next_index(Head);
+        long n1 = length < (long)allocated - first ? length : (long)allocated - first;
+        try{
+            _transfer_n(Array + first, n1, temp + 1);
+        }
+        catch(...){
+            _deallocate(temp, tempsize);
+            throw;
+        }
+        try{
+            _transfer_n(Array, length - n1, temp + 1 + n1);
+        }
+        catch(...){
+            for(long i=1; i<=n1; i++){
+                _destroy(&temp[i]);
+            }
+            _deallocate(temp, tempsize);
+            throw;
+        }
+    }
+    _destroy_elements();
+    _deallocate(Array, allocated);
+    Array = temp;
+    allocated = tempsize;
+    Head = 0;
+    Tail = length;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_grow_for(const long n){
+    size_t required = length + n + 1;
+    if(n <= 0 || required <= allocated){
+        return;
+    }
+    size_t grown = RESIZE_FACTOR*allocated;
+    _reallocate(_capacity(required>grown?required:grown));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_shrink_if_necessary(){
+    if(length < allocated*SHRINK_THRESHOLD && allocated/RESIZE_FACTOR > INITIAL_ARRAY_SIZE){
+        size_t newsize = _capacity(std::max<size_t>(RESIZE_FACTOR*(length + 1), length + 2));
+        if(newsize < allocated){
+            _reallocate(newsize);
+        }
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_open(const long position, const long n){
+    if(position >= length - position){
+        long source = Tail;
+        long dest = _wrap(Tail + n);
+        for(long i = length - 1; i >= position; i--){
+            if(i + n >= length){
+                _construct(&Array[dest], std::move(Array[source]));
+            }
+            else{
+                Array[dest] = std::move(Array[source]);
+            }
+            source = _prev_index(source);
+            dest = _prev_index(dest);
+        }
+        long slot = _transform_index(position);
+        for(long i = std::min(n, length - position); i > 0; i--){
+            _destroy(&Array[slot]);
+            slot = _next_index(slot);
+        }
+        Tail = _wrap(Tail + n);
+    }
+    else{
+        long source = _next_index(Head);
+        long dest = _wrap(Head + 1 + allocated - n);
+        for(long i = 0; i < position; i++){
+            if(i < n){
+                _construct(&Array[dest], std::move(Array[source]));
+            }
+            else{
+                Array[dest] = std::move(Array[source]);
+            }
+            source = _next_index(source);
+            dest = _next_index(dest);
+        }
+        long slot = _transform_index(std::max(position - n, 0L));
+        for(long i = std::min(n, position); i > 0; i--){
+            _destroy(&Array[slot]);
+            slot = _next_index(slot);
+        }
+        Head = _wrap(Head + allocated - n);
+    }
+    length += n;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_erase(const long position, const long stride, const long n){
+    long last = position + (n - 1)*stride;
+    long next = 0;
+    long erased = 0;
+    if(length - position <= last + 1){
+        long dest = _transform_index(position);
+        long source = dest;
+        next = position;
+        for(long i = position; i < length; i++){
+            if(erased < n && i == next){
+                ++erased;
+                next += stride;
+            }
+            else{
+                Array[dest] = std::move(Array[source]);
+                dest = _next_index(dest);
+            }
+            source = _next_index(source);
+        }
+        for(long i = 0; i < n; i++){
+            _destroy(&Array[dest]);
+            dest = _next_index(dest);
+        }
+        Tail = _wrap(Tail + allocated - n);
+    }
+    else{
+        long dest = _transform_index(last);
+        long source = dest;
+        next = last;
+        for(long i = last; i >= 0; i--){
+            if(erased < n && i == next){
+                ++erased;
+                next -= stride;
+            }
+            else{
+                Array[dest] = std::move(Array[source]);
+                dest = _prev_index(dest);
+            }
+            source = _prev_index(source);
+        }
+        for(long i = 0; i < n; i++){
+            _destroy(&Array[dest]);
+            dest = _prev_index(dest);
+        }
+        Head = _wrap(Head + n);
+    }
+    length -= n;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_append_from(const pyList<Type, Allocator, Policy, InlineBytes> & List, const long n, const long first){
+    long i = 0;
+    while(i < n){
+        long source = List._transform_index(first + i);
+        long dest = _next_index(Tail);
+        long chunk = n - i;
+        chunk = chunk < (long)List.allocated - source ? chunk : (long)List.allocated - source;
+        chunk = chunk < (long)allocated - dest ? chunk : (long)allocated - dest;
+        _copy_n(List.Array + source, chunk, Array + dest);
+        Tail = dest + chunk - 1;
+        length += chunk;
+        i += chunk;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_swap(pyList<Type, Allocator, Policy, InlineBytes> & List){
+    if(_is_inline() || List._is_inline()){
+        pyList<Type, Allocator, Policy, InlineBytes> temp(std::move(List));
+        List._steal(*this);
+        _steal(temp);
+        std::swap(alloc, List.alloc);
+        return;
+    }
+    std::swap(Head, List.Head);
+    std::swap(Tail, List.Tail);
+    std::swap(length, List.length);
+    std::swap(allocated, List.allocated);
+    std::swap(Array, List.Array);
+    std::swap(alloc, List.alloc);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> & pyList<Type, Allocator, Policy, InlineBytes>::operator = (pyList<Type, Allocator, Policy, InlineBytes> rhs){
+    this->_swap(rhs);
+    return *this;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> & pyList<Type, Allocator, Policy, InlineBytes>::operator = (const pyListView<Type> & View){
+    pyList<Type, Allocator, Policy, InlineBytes> temp(View, AllocTraits::select_on_container_copy_construction(alloc));
+    this->_swap(temp);
+    return *this;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Derived>
+pyList<Type, Allocator, Policy, InlineBytes> & pyList<Type, Allocator, Policy, InlineBytes>::operator = (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> & Expr){
+    pyList<Type, Allocator, Policy, InlineBytes> temp(Expr);
+    this->_swap(temp);
+    return *this;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type & pyList<Type, Allocator, Policy, InlineBytes>::operator [] (const long index){
+    _detach();
+    long act_index = _transform_index(index);
+    return Array[act_index];
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+const Type & pyList<Type, Allocator, Policy, InlineBytes>::operator [] (const long index) const {
+    long act_index = _transform_index(index);
+    return Array[act_index];
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyListView<Type> pyList<Type, Allocator, Policy, InlineBytes>::operator () (const long start, const long stop, const long step) const & {
+    long first;
+    long n = pySliceBounds(length, start, stop, step, first);
+    if(n == 0){
+        return pyListView<Type>();
+    }
+    return pyListView<Type>(Array, allocated, _transform_index(first), step, n);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> pyList<Type, Allocator, Policy, InlineBytes>::operator () (const long start, const long stop, const long step) && {
+    return slice(start, stop, step);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator == (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    if(length != rhs.length){ return false; }
+    if(this != &rhs){
+        long i = 0;
+        while(i < length){
+            long run1, run2;
+            const Type *a = _span(i, run1);
+            const Type *b = rhs._span(i, run2);
+            long n = std::min(run1, run2);
+            if(!pyReduce<Type>::equal(a, b, n)){ return false; }
+            i += n;
+        }
+    }
+    return true;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator != (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    return !((*this) == rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator < (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    long min_len = length < rhs.length ? length : rhs.length;
+    long i = 0;
+    while(i < min_len){
+        long run1, run2;
+        const Type *a = _span(i, run1);
+        const Type *b = rhs._span(i, run2);
+        long n = std::min(std::min(run1, run2), min_len - i);
+        long k = pyReduce<Type>::mismatch(a, b, n);
+        if(k < n){
+            return a[k] < b[k];
+        }
+        i += n;
+    }
+    if(length < rhs.length){
+        return true;
+    }
+    return false;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator >= (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    return !((*this) < rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator <= (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    return !((*this) > rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::operator > (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    return (rhs < (*this));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>> pyList<Type, Allocator, Policy, InlineBytes>::operator + (const pyList<Type, Allocator, Policy, InlineBytes> & rhs) const {
+    return pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>>(pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>(*this), pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>(rhs));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Derived>
+pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, Derived> pyList<Type, Allocator, Policy, InlineBytes>::operator + (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> & rhs) const {
+    return pyConcatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>, Derived>(pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>(*this), rhs.self());
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::operator += (const pyList<Type, Allocator, Policy, InlineBytes> & rhs){
+    this->extend(rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Derived>
+void pyList<Type, Allocator, Policy, InlineBytes>::operator += (const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> & rhs){
+    this->extend(rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyRepeatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>> pyList<Type, Allocator, Policy, InlineBytes>::operator * (const long rhs) const {
+    return pyRepeatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>>(pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>(*this), rhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::operator *= (const long rhs){
+    _detach();
+    if(rhs <= 0){
+        clear();
+        return;
+    }
+    long total = rhs*length;
+    _grow_for(total - length);
+    while(length < total){
+        _append_from(*this, length < total - length ? length : total - length);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyRepeatExpr<pyList<Type, Allocator, Policy, InlineBytes>, pyListLeaf<pyList<Type, Allocator, Policy, InlineBytes>>> operator * (const long lhs, const pyList<Type, Allocator, Policy, InlineBytes> & rhs){
+    return (rhs*lhs);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::ostream & operator << (std::ostream & o, const pyList<Type, Allocator, Policy, InlineBytes> & List){
+    o << "[";
+    int flag = 0;
+    long n = List.len();
+    for(long i=0; i < n; i++){
+        if(flag == 0){ o << List[i] ; ++flag;}
+        else{ o << ", " << List[i]; }
+    }
+    return o << "]";
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+inline long pyList<Type, Allocator, Policy, InlineBytes>::_transform_index(const long index) const{
+    long act_index = (index>=0) ? (index) : (index + length);
+    act_index = _wrap(act_index + Head + 1);
+    return act_index;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+inline const Type * pyList<Type, Allocator, Policy, InlineBytes>::_span(const long index, long & run) const{
+    long position = _transform_index(index);
+    run = std::min(length - index, (long)allocated - position);
+    return Array + position;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+inline long pyList<Type, Allocator, Policy, InlineBytes>::_untransform_index(const long index) const{
+    if(Head < Tail){
+        return index - Head - 1;
+    }
+    else {
+        if(index > Head){
+            return index - Head - 1;
+        }
+        else{
+            return index + allocated - Head - 1;
+        }
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+size_t pyList<Type, Allocator, Policy, InlineBytes>::_round_capacity(const size_t size) const {
+    if(Policy::power_of_two){
+        size_t rounded = 1;
+        while(rounded < size){
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+    return size;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+size_t pyList<Type, Allocator, Policy, InlineBytes>::_capacity(const size_t request_size) const {
+    return _round_capacity(request_size>INITIAL_ARRAY_SIZE?request_size:INITIAL_ARRAY_SIZE);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long pyList<Type, Allocator, Policy, InlineBytes>::_clamp(const long value, const long min_value, const long max_value) const {
+    if(value < min_value){
+        return min_value;
+    }
+    else if(value > max_value){
+        return max_value;
+    }
+    return value;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long pyList<Type, Allocator, Policy, InlineBytes>::_len_between(const long start, const long stop) const {
+    if(start <= stop){
+        return stop - start;
+    }
+    else{
+        return allocated - start + stop;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_resize_if_necessary(){
+    size_t newsize;
+    if(length + 1 >= (long)allocated){
+        newsize = _capacity(std::max<size_t>(RESIZE_FACTOR*allocated, length + 2));
+    }
+    else if(length < allocated*SHRINK_THRESHOLD && allocated/RESIZE_FACTOR > INITIAL_ARRAY_SIZE){
+        newsize = _capacity(std::max<size_t>(allocated/RESIZE_FACTOR, length + 2));
+    }
+    else{
+        return;
+    }
+    _reallocate(newsize);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_linearize(){
+    if(length == 0 || _next_index(Head) <= Tail){
+        return;
+    }
+    if(!_is_inline()){
+        _reallocate(allocated);
+        return;
+    }
+    if constexpr(std::is_nothrow_move_constructible<Type>::value && std::is_nothrow_move_assignable<Type>::value){
+        long first = _next_index(Head);
+        long low = Tail + 1;
+        for(long i = first; i < (long)allocated; i++){
+            long dest = low + i - first;
+            if(dest < first){
+                _construct(&Array[dest], std::move(Array[i]));
+            }
+            else{
+                Array[dest] = std::move(Array[i]);
+            }
+        }
+        for(long i = std::max(first, length); i < (long)allocated; i++){
+            _destroy(&Array[i]);
+        }
+        std::rotate(Array, Array + low, Array + length);
+        _construct(&Array[length], std::move(Array[length - 1]));
+        for(long i = length - 1; i > 0; i--){
+            Array[i] = std::move(Array[i - 1]);
+        }
+        _destroy(&Array[0]);
+        Head = 0;
+        Tail = length;
+    }
+    else{
+        _reallocate(allocated);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_sort2(Type * a, Type * b){
+    if(*b < *a){
+        std::swap(*a, *b);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_sort3(Type * a, Type * b, Type * c){
+    _sort2(a, b);
+    _sort2(b, c);
+    _sort2(a, b);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_insertion_sort(Type * first, Type * last){
+    if(first == last){
+        return;
+    }
+    for(Type *i = first + 1; i != last; ++i){
+        if(*i < *(i - 1)){
+            Type temp = std::move(*i);
+            Type *j = i;
+            do{
+                *j = std::move(*(j - 1));
+                --j;
+            }while(j != first && temp < *(j - 1));
+            *j = std::move(temp);
+        }
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+bool pyList<Type, Allocator, Policy, InlineBytes>::_partial_insertion_sort(Type * first, Type * last){
+    if(first == last){
+        return true;
+    }
+    long moved = 0;
+    for(Type *i = first + 1; i != last; ++i){
+        if(*i < *(i - 1)){
+            Type temp = std::move(*i);
+            Type *j = i;
+            do{
+                *j = std::move(*(j - 1));
+                --j;
+            }while(j != first && temp < *(j - 1));
+            *j = std::move(temp);
+            moved += i - j;
+        }
+        if(moved > PARTIAL_INSERTION_LIMIT){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_sift_down(Type * first, const long n, long root){
+    Type temp = std::move(first[root]);
+    long child;
+    while((child = 2*root + 1) < n){
+        if(child + 1 < n && first[child] < first[child + 1]){
+            ++child;
+        }
+        if(!(temp < first[child])){
+            break;
+        }
+        first[root] = std::move(first[child]);
+        root = child;
+    }
+    first[root] = std::move(temp);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_heapsort(Type * first, Type * last){
+    long n = last - first;
+    for(long i = n/2 - 1; i >= 0; i--){
+        _sift_down(first, n, i);
+    }
+    for(long i = n - 1; i > 0; i--){
+        std::swap(first[0], first[i]);
+        _sift_down(first, i, 0);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type * pyList<Type, Allocator, Policy, InlineBytes>::_partition_left(Type * begin, Type * end){
+    Type pivot = std::move(*begin);
+    Type *first = begin;
+    Type *last = end;
+    while(pivot < *--last);
+    if(last + 1 == end){
+        while(first < last && !(pivot < *++first));
+    }
+    else{
+        while(!(pivot < *++first));
+    }
+    while(first < last){
+        std::swap(*first, *last);
+        while(pivot < *--last);
+        while(!(pivot < *++first));
+    }
+    *begin = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type * pyList<Type, Allocator, Policy, InlineBytes>::_partition_right(Type * begin, Type * end, bool & already_partitioned){
+    Type pivot = std::move(*begin);
+    Type *first = begin;
+    Type *last = end;
+    while(*++first < pivot);
+    if(first - 1 == begin){
+        while(first < last && !(*--last < pivot));
+    }
+    else{
+        while(!(*--last < pivot));
+    }
+    already_partitioned = first >= last;
+    while(first < last){
+        std::swap(*first, *last);
+        while(*++first < pivot);
+        while(!(*--last < pivot));
+    }
+    Type *pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_introsort(Type * begin, Type * end, int bad_allowed, bool leftmost){
+    while(true){
+        long size = end - begin;
+        if(size < INSERTION_SORT_THRESHOLD){
+            _insertion_sort(begin, end);
+            return;
+        }
+        long half = size/2;
+        if(size > NINTHER_THRESHOLD){
+            _sort3(begin, begin + half, end - 1);
+            _sort3(begin + 1, begin + half - 1, end - 2);
+            _sort3(begin + 2, begin + half + 1, end - 3);
+            _sort3(begin + half - 1, begin + half, begin + half + 1);
+            std::swap(*begin, *(begin + half));
+        }
+        else{
+            _sort3(begin + half, begin, end - 1);
+        }
+        if(!leftmost && !(*(begin - 1) < *begin)){
+            begin = _partition_left(begin, end) + 1;
+            continue;
+        }
+        bool already_partitioned;
+        Type *pivot_pos = _partition_right(begin, end, already_partitioned);
+        long left_size = pivot_pos - begin;
+        long right_size = end - (pivot_pos + 1);
+        if(left_size < size/8 || right_size < size/8){
+            if(--bad_allowed == 0){
+                _heapsort(begin, end);
+                return;
+            }
+            if(left_size >= INSERTION_SORT_THRESHOLD){
+                std::swap(*begin, *(begin + left_size/4));
+                std::swap(*(pivot_pos - 1), *(pivot_pos - left_size/4));
+            }
+            if(right_size >= INSERTION_SORT_THRESHOLD){
+                std::swap(*(pivot_pos + 1), *(pivot_pos + 1 + right_size/4));
+                std::swap(*(end - 1), *(end - right_size/4));
+            }
+        }
+        else if(already_partitioned && _partial_insertion_sort(begin, pivot_pos) && _partial_insertion_sort(pivot_pos + 1, end)){
+            return;
+        }
+        _introsort(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_testsort() const {
+    Type prev = (*this)[0];
+    for(unsigned long i=1; i < length; i++){
+        if((*this)[i]< prev){
+            std::cerr << "Incorrect sort" << std::endl;
+        }
+        prev = (*this)[i];
+    }
+    std::cout << "Correct sort" << std::endl;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+inline long pyList<Type, Allocator, Policy, InlineBytes>::len() const{
+    return length;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::sort(const bool reverse){
+    _detach();
+    if(length <= 1){
+        return;
+    }
+    _linearize();
+    Type *first = Array + _next_index(Head);
+    if constexpr(pyRadixSort<Type>::enabled){
+        if(length >= RADIX_SORT_THRESHOLD){
+            pyRadixSort<Type>::sort(first, length, reverse);
+            return;
+        }
+    }
+    if(reverse){
+        pyTimSort<Type, pyGreater<Type>>::sort(first, length, pyGreater<Type>());
+    }
+    else{
+        pyTimSort<Type, pyLess<Type>>::sort(first, length, pyLess<Type>());
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::sort(const pyParallelPolicy &, const bool reverse){
+    _detach();
+    if(length < PARALLEL_SORT_THRESHOLD){
+        sort(reverse);
+        return;
+    }
+    _linearize();
+    Type *first = Array + _next_index(Head);
+    if(reverse){
+        pyParallelSort<Type, pyGreater<Type>>::sort(first, length, pyGreater<Type>(), pyThreadPool::instance());
+    }
+    else{
+        pyParallelSort<Type, pyLess<Type>>::sort(first, length, pyLess<Type>(), pyThreadPool::instance());
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Key>
+void pyList<Type, Allocator, Policy, InlineBytes>::sort(Key key, const bool reverse){
+    _detach();
+    if(length <= 1){
+        return;
+    }
+    _linearize();
+    Type *first = Array + _next_index(Head);
+    typedef typename std::decay<decltype(key(*first))>::type KeyType;
+    typedef std::pair<KeyType, long> Decorated;
+    std::vector<Decorated> decorated;
+    decorated.reserve(length);
+    for(long i=0; i<length; i++){
+        decorated.emplace_back(key(first[i]), i);
+    }
+    if(reverse){
+        auto compare = [](const Decorated & a, const Decorated & b){ return b.first < a.first; };
+        pyTimSort<Decorated, decltype(compare)>::sort(decorated.data(), length, compare);
+    }
+    else{
+        auto compare = [](const Decorated & a, const Decorated & b){ return a.first < b.first; };
+        pyTimSort<Decorated, decltype(compare)>::sort(decorated.data(), length, compare);
+    }
+    for(long i=0; i<length; i++){
+        if(decorated[i].second == i){
+            continue;
+        }
+        Type temp = std::move(first[i]);
+        long j = i;
+        while(decorated[j].second != i){
+            long source = decorated[j].second;
+            first[j] = std::move(first[source]);
+            decorated[j].second = j;
+            j = source;
+        }
+        first[j] = std::move(temp);
+        decorated[j].second = j;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::sort_unstable(){
+    _detach();
+    if(length <= 1){
+        return;
+    }
+    _linearize();
+    Type *first = Array + _next_index(Head);
+    Type *last = first + length;
+    Type *run = first + 1;
+    while(run != last && !(*run < *(run - 1))){
+        ++run;
+    }
+    if(run == last){
+        return;
+    }
+    if(run == first + 1){
+        while(run != last && *run < *(run - 1)){
+            ++run;
+        }
+        if(run == last){
+            std::reverse(first, last);
+            return;
+        }
+    }
+    int bad_allowed = 1;
+    for(long n = length; n > 1; n >>= 1){
+        ++bad_allowed;
+    }
+    _introsort(first, last, bad_allowed, true);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::reverse(){
+    _detach();
+    if(length <= 1){
+        return;
+    }
+    long k = length/2;
+    long index1 = _next_index(Head);
+    long index2 = Tail;
+    for(unsigned long i=0; i<k; i++){
+        std::swap(Array[index1], Array[index2]);
+        index1 = _next_index(index1);
+        index2 = _prev_index(index2);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+const Type & pyList<Type, Allocator, Policy, InlineBytes>::get(const long index) const {
+    if(index < length && index >= -length){
+        long act_index = _transform_index(index);
+        return Array[act_index];
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::set(const long index, const Type & key){
+    _detach();
+    if(index < length && index >= -length){
+        long act_index = _transform_index(index);
+        Array[act_index] = key;
+    }
+    else{
+        throw std::invalid_argument("list index out of range");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::set(const long index, Type && key){
+    _detach();
+    if(index < length && index >= -length){
+        long act_index = _transform_index(index);
+        Array[act_index] = std::move(key);
+    }
+    else{
+        throw std::invalid_argument("list index out of range");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::append(const Type & key){
+    emplace_back(key);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::append(Type && key){
+    emplace_back(std::move(key));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename... Args>
+Type & pyList<Type, Allocator, Policy, InlineBytes>::emplace_back(Args &&... args){
+    _detach();
+    long new_tail;
+    if(length + 1 >= (long)allocated){
+        Type value(std::forward<Args>(args)...);
+        _resize_if_necessary();
+        new_tail = _next_index(Tail);
+        _construct(&Array[new_tail], std::move(value));
+    }
+    else{
+        new_tail = _next_index(Tail);
+        _construct(&Array[new_tail], std::forward<Args>(args)...);
+    }
+    Tail = new_tail;
+    ++length;
+    return Array[Tail];
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type pyList<Type, Allocator, Policy, InlineBytes>::max(){
+    if(length == 0){
+        throw std::domain_error("max of empty list");
+    }
+    long start = _next_index(Head);
+    long first = _first_segment();
+    Type maximum = pyReduce<Type>::max(Array + start + 1, first - 1, Array[start]);
+    return pyReduce<Type>::max(Array, length - first, maximum);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type pyList<Type, Allocator, Policy, InlineBytes>::min(){
+    if(length == 0){
+        throw std::domain_error("min of empty list");
+    }
+    long start = _next_index(Head);
+    long first = _first_segment();
+    Type minimum = pyReduce<Type>::min(Array + start + 1, first - 1, Array[start]);
+    return pyReduce<Type>::min(Array, length - first, minimum);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type pyList<Type, Allocator, Policy, InlineBytes>::sum(){
+    Type total = 0;
+    if(length == 0){
+        return total;
+    }
+    long first = _first_segment();
+    total = pyReduce<Type>::sum(Array + _next_index(Head), first, total);
+    return pyReduce<Type>::sum(Array, length - first, total);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::extend(const pyList<Type, Allocator, Policy, InlineBytes> & List){
+    _detach();
+    long n = List.length;
+    _grow_for(n);
+    _append_from(List, n);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename Derived>
+void pyList<Type, Allocator, Policy, InlineBytes>::extend(const pyListExpr<pyList<Type, Allocator, Policy, InlineBytes>, Derived> & Expr){
+    _detach();
+    _grow_for(Expr.self().len());
+    Expr.self()._write(*this);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> pyList<Type, Allocator, Policy, InlineBytes>::slice(const long start, const long stop, const long step) const {
+    return pyList<Type, Allocator, Policy, InlineBytes>((*this)(start, stop, step), AllocTraits::select_on_container_copy_construction(alloc));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::set_slice(const long start, const long stop, const long step, const pyList<Type, Allocator, Policy, InlineBytes> & List){
+    if(&List == this){
+        pyList<Type, Allocator, Policy, InlineBytes> temp(List);
+        set_slice(start, stop, step, temp);
+        return;
+    }
+    _detach();
+    long first;
+    long n = pySliceBounds(length, start, stop, step, first);
+    long m = List.length;
+    if(step != 1){
+        if(m != n){
+            throw std::invalid_argument("attempt to assign sequence of size " + std::to_string(m) + " to extended slice of size " + std::to_string(n));
+        }
+        for(long i = 0; i < n; i++){
+            Array[_transform_index(first + i*step)] = List[i];
+        }
+        return;
+    }
+    long common = std::min(n, m);
+    long slot = common > 0 ? _transform_index(first) : 0;
+    for(long i = 0; i < common; i++){
+        Array[slot] = List[i];
+        slot = _next_index(slot);
+    }
+    if(m < n){
+        _erase(first + m, 1, n - m);
+        _shrink_if_necessary();
+    }
+    else if(m > n){
+        pyList<Type, Allocator, Policy, InlineBytes> extra(List(n, m), AllocTraits::select_on_container_copy_construction(alloc));
+        if constexpr(std::is_nothrow_move_constructible<Type>::value && std::is_nothrow_move_assignable<Type>::value){
+            _grow_for(m - n);
+            _open(first + n, m - n);
+            slot = _transform_index(first + n);
+            for(long i = 0; i < m - n; i++){
+                _construct(&Array[slot], std::move(extra[i]));
+                slot = _next_index(slot);
+            }
+        }
+        else{
+            pyList<Type, Allocator, Policy, InlineBytes> result((*this)(0, first + n), AllocTraits::select_on_container_copy_construction(alloc));
+            result.reserve(length + m - n);
+            for(long i = 0; i < m - n; i++){
+                result.append(std::move(extra[i]));
+            }
+            for(long i = first + n; i < length; i++){
+                result.append((*this)[i]);
+            }
+            _swap(result);
+        }
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::del_slice(const long start, const long stop, const long step){
+    _detach();
+    long first;
+    long n = pySliceBounds(length, start, stop, step, first);
+    if(n == 0){
+        return;
+    }
+    if(step < 0){
+        first += (n - 1)*step;
+    }
+    _erase(first, step < 0 ? -step : step, n);
+    _shrink_if_necessary();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+Type pyList<Type, Allocator, Policy, InlineBytes>::pop(const long index){
+    _detach();
+    if(index<length && -index<=length){
+        long act_index = _transform_index(index);
+        Type key = std::move(Array[act_index]);
+        if(_len_between(act_index,Tail) < length/2){
+            while(act_index != Tail){
+                long next_index = _next_index(act_index);
+                Array[act_index] = std::move(Array[next_index]);
+                act_index = next_index;
+            }
+            _destroy(&Array[Tail]);
+            Tail = _prev_index(Tail);
+        }
+        else{
+            long head_next = _next_index(Head);
+            while(act_index != head_next){
+                long prev_index = _prev_index(act_index);
+                Array[act_index] = std::move(Array[prev_index]);
+                act_index = prev_index;
+            }
+            _destroy(&Array[head_next]);
+            Head = head_next;
+        }
+        --length;
+        _resize_if_necessary();
+        return key;
+    }
+    else{
+        throw std::invalid_argument("pop index out of range");
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::remove(const Type & key){
+    _detach();
+    long index = Head;
+    while(index != Tail){
+        index = _next_index(index);
+        if(Array[index] == key){
+            index = _untransform_index(index);
+            pop(index);
+            return;
+        }
+    }
+    throw std::invalid_argument("Value not in list");
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::clear(){
+    _release();
+    _reset_empty();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long pyList<Type, Allocator, Policy, InlineBytes>::count(const Type & key) const{
+    if(length == 0){
+        return 0;
+    }
+    long first = _first_segment();
+    return pyReduce<Type>::count(Array + _next_index(Head), first, key) + pyReduce<Type>::count(Array, length - first, key);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long pyList<Type, Allocator, Policy, InlineBytes>::index(const Type & key, const long start, const long stop){
+    if(length == 0){
+        throw std::invalid_argument("Value not in list");
+    }
+    long stop_clamped = _clamp(stop,-length-1,length);
+    stop_clamped = stop_clamped>=0? stop_clamped:stop_clamped + length;
+    long start_clamped = _clamp(start,-length, length);
+    start_clamped = start_clamped>=0? start_clamped: start_clamped + length;
+
+    long position = start_clamped;
+    while(position < stop_clamped){
+        long run;
+        const Type *first = _span(position, run);
+        run = std::min(run, stop_clamped - position);
+        long k = pyReduce<Type>::find(first, run, key);
+        if(k < run){
+            return position + k;
+        }
+        position += run;
+    }
+    throw std::invalid_argument("Value not in list");
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::insert(const long index, const Type & key){
+    emplace(index, key);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::insert(const long index, Type && key){
+    emplace(index, std::move(key));
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+template<typename... Args>
+Type & pyList<Type, Allocator, Policy, InlineBytes>::emplace(const long index, Args &&... args){
+    _detach();
+    long position = _clamp(index,-length,length);
+    position = position>=0? position: position + length;
+    if(position == length){
+        return emplace_back(std::forward<Args>(args)...);
+    }
+    Type value(std::forward<Args>(args)...);
+    _grow_for(1);
+    long act_index = _transform_index(position);
+    if(position >= length/2){
+        long new_tail = _next_index(Tail);
+        _construct(&Array[new_tail], std::move(Array[Tail]));
+        Tail = new_tail;
+        ++length;
+        long i = _prev_index(new_tail);
+        while(i != act_index){
+            long prev_index = _prev_index(i);
+            Array[i] = std::move(Array[prev_index]);
+            i = prev_index;
+        }
+        Array[act_index] = std::move(value);
+        return Array[act_index];
+    }
+    else{
+        long slot = _prev_index(act_index);
+        long head_next = _next_index(Head);
+        if(slot == Head){
+            _construct(&Array[Head], std::move(value));
+            Head = _prev_index(Head);
+            ++length;
+            return Array[slot];
+        }
+        _construct(&Array[Head], std::move(Array[head_next]));
+        Head = _prev_index(Head);
+        ++length;
+        long i = head_next;
+        while(i != slot){
+            long next_index = _next_index(i);
+            Array[i] = std::move(Array[next_index]);
+            i = next_index;
+        }
+        Array[slot] = std::move(value);
+        return Array[slot];
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::array<pySegment<Type>, 2> pyList<Type, Allocator, Policy, InlineBytes>::segments(){
+    _detach();
+    if(length == 0){
+        return {{{Array, 0}, {Array, 0}}};
+    }
+    long first = _first_segment();
+    return {{{Array + _next_index(Head), first}, {Array, length - first}}};
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::array<pySegment<const Type>, 2> pyList<Type, Allocator, Policy, InlineBytes>::segments() const {
+    if(length == 0){
+        return {{{Array, 0}, {Array, 0}}};
+    }
+    long first = _first_segment();
+    return {{{Array + _next_index(Head), first}, {Array, length - first}}};
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::reserve(const long n){
+    _detach();
+    if(n + 1 > (long)allocated){
+        _reallocate(_round_capacity(n + 1));
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long pyList<Type, Allocator, Policy, InlineBytes>::capacity() const {
+    return allocated > 0 ? allocated - 1 : 0;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::shrink_to_fit(){
+    _detach();
+    if(length == 0){
+        clear();
+        return;
+    }
+    size_t fitted = _round_capacity(length + 1);
+    if(fitted < allocated && !_is_inline()){
+        _reallocate(fitted);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::_read_items(std::istream & in, const long n, const bool swapped){
+    _release();
+    _init_storage(n + 1);
+    if(n > 0){
+        if(!in.read(reinterpret_cast<char *>(Array + 1), n*sizeof(Type))){
+            throw std::invalid_argument("truncated pyList file");
+        }
+        if(swapped){
+            pySwapBytes(Array + 1, sizeof(Type), n);
+        }
+        Tail = n;
+        length = n;
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::save(const std::string & path) const {
+    typedef typename pyListTraits<Type>::element_type Item;
+    static_assert(std::is_trivially_copyable<Item>::value, "save requires trivially copyable elements");
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out){
+        throw std::runtime_error("cannot open " + path);
+    }
+    uint64_t total = length;
+    std::vector<uint64_t> offsets;
+    if constexpr(pyListTraits<Type>::nested){
+        offsets.reserve(length + 1);
+        offsets.push_back(0);
+        for(const Type & row:*this){
+            offsets.push_back(offsets.back() + row.len());
+        }
+        total = offsets.back();
+    }
+    pyListHeader header = pyListHeader::make(pyTypeTag<Item>::value, sizeof(Item), pyListTraits<Type>::nested, length, total);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(offsets.data()), offsets.size()*sizeof(uint64_t));
+    static const char zeros[pyListHeader::ALIGNMENT] = {};
+    out.write(zeros, header.data_offset - sizeof(header) - offsets.size()*sizeof(uint64_t));
+    if constexpr(pyListTraits<Type>::nested){
+        for(const Type & row:*this){
+            for(const pySegment<const Item> & segment:row.segments()){
+                out.write(reinterpret_cast<const char *>(segment.begin()), segment.len()*sizeof(Item));
+            }
+        }
+    }
+    else{
+        for(const pySegment<const Type> & segment:segments()){
+            out.write(reinterpret_cast<const char *>(segment.begin()), segment.len()*sizeof(Type));
+        }
+    }
+    if(!out.flush()){
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> pyList<Type, Allocator, Policy, InlineBytes>::load(const std::string & path, const Allocator & allocator){
+    typedef typename pyListTraits<Type>::element_type Item;
+    static_assert(std::is_trivially_copyable<Item>::value, "load requires trivially copyable elements");
+    std::ifstream in(path, std::ios::binary);
+    if(!in){
+        throw std::runtime_error("cannot open " + path);
+    }
+    pyListHeader header;
+    if(!in.read(reinterpret_cast<char *>(&header), sizeof(header))){
+        throw std::invalid_argument("not a pyList file");
+    }
+    bool swapped = header.validate(pyTypeTag<Item>::value, sizeof(Item), pyListTraits<Type>::nested);
+    in.seekg(0, std::ios::end);
+    header.check_size(in.tellg(), alignof(Item));
+    in.seekg(sizeof(header));
+    pyList<Type, Allocator, Policy, InlineBytes> result(allocator);
+    if constexpr(pyListTraits<Type>::nested){
+        std::vector<uint64_t> offsets(header.length + 1);
+        if(!in.read(reinterpret_cast<char *>(offsets.data()), offsets.size()*sizeof(uint64_t))){
+            throw std::invalid_argument("truncated pyList file");
+        }
+        if(swapped){
+            pySwapBytes(offsets.data(), sizeof(uint64_t), offsets.size());
+        }
+        for(size_t i=0; i+1<offsets.size(); i++){
+            if(offsets[i] > offsets[i + 1]){
+                throw std::invalid_argument("corrupt pyList file");
+            }
+        }
+        if(offsets[0] != 0 || offsets.back() != header.data_length){
+            throw std::invalid_argument("corrupt pyList file");
+        }
+        in.seekg(header.data_offset);
+        result.reserve(header.length);
+        for(uint64_t i=0; i<header.length; i++){
+            Type row;
+            row._read_items(in, offsets[i + 1] - offsets[i], swapped);
+            result.append(std::move(row));
+        }
+    }
+    else{
+        in.seekg(header.data_offset);
+        result._read_items(in, header.length, swapped);
+    }
+    return result;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyMappedList<Type> pyList<Type, Allocator, Policy, InlineBytes>::mmap(const std::string & path){
+    return pyMappedList<Type>(path);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::write_repr(std::string & buffer) const {
+    if constexpr(std::is_arithmetic<Type>::value){
+        buffer += '[';
+        for(const pySegment<const Type> & segment:segments()){
+            for(long i=0; i<segment.len(); i+=REPR_BLOCK){
+                long n = std::min(REPR_BLOCK, segment.len() - i);
+                size_t used = buffer.size();
+                buffer.resize(used + n*(pyRepr<Type>::WIDTH + 2));
+                char *out = &buffer[used];
+                for(const Type *item = segment.begin() + i; item != segment.begin() + i + n; ++item){
+                    out = pyRepr<Type>::format(out, *item);
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                buffer.resize(out - buffer.data());
+            }
+        }
+        if(length > 0){
+            buffer.resize(buffer.size() - 2);
+        }
+        buffer += ']';
+        return;
+    }
+    buffer += '[';
+    for(const pySegment<const Type> & segment:segments()){
+        for(const Type & item:segment){
+            if constexpr(pyListTraits<Type>::nested){
+                item.write_repr(buffer);
+            }
+            else{
+                pyRepr<Type>::write(buffer, item);
+            }
+            buffer += ", ";
+        }
+    }
+    if(length > 0){
+        buffer.resize(buffer.size() - 2);
+    }
+    buffer += ']';
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void pyList<Type, Allocator, Policy, InlineBytes>::write_repr(std::ostream & o) const {
+    std::string buffer;
+    write_repr(buffer);
+    o.write(buffer.data(), buffer.size());
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+std::string pyList<Type, Allocator, Policy, InlineBytes>::to_string() const {
+    std::string buffer;
+    buffer.reserve(2 + 4*length);
+    write_repr(buffer);
+    return buffer;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+const char * pyList<Type, Allocator, Policy, InlineBytes>::_read_repr(const char * first, const char * last){
+    first = pySkipSpace(first, last);
+    if(first == last || *first != '['){
+        throw std::invalid_argument("ValueError: malformed list repr");
+    }
+    first = pySkipSpace(first + 1, last);
+    if(first != last && *first == ']'){
+        return first + 1;
+    }
+    while(true){
+        if constexpr(pyListTraits<Type>::nested){
+            Type row;
+            first = row._read_repr(first, last);
+            append(std::move(row));
+        }
+        else{
+            Type item;
+            first = pyRepr<Type>::read(pySkipSpace(first, last), last, item);
+            append(std::move(item));
+        }
+        first = pySkipSpace(first, last);
+        if(first != last && *first == ','){
+            first = pySkipSpace(first + 1, last);
+            if(first != last && *first == ']'){
+                return first + 1;
+            }
+        }
+        else if(first != last && *first == ']'){
+            return first + 1;
+        }
+        else{
+            throw std::invalid_argument("ValueError: malformed list repr");
+        }
+    }
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> pyList<Type, Allocator, Policy, InlineBytes>::parse(std::string_view text, const Allocator & allocator){
+    pyList<Type, Allocator, Policy, InlineBytes> result(allocator);
+    const char *last = text.data() + text.size();
+    if(pySkipSpace(result._read_repr(text.data(), last), last) != last){
+        throw std::invalid_argument("ValueError: malformed list repr");
+    }
+    return result;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+pyList<Type, Allocator, Policy, InlineBytes> sorted(pyList<Type, Allocator, Policy, InlineBytes> List, const bool reverse = false){
+    List.sort(reverse);
+    return List;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Key>
+pyList<Type, Allocator, Policy, InlineBytes> sorted(pyList<Type, Allocator, Policy, InlineBytes> List, Key key, const bool reverse = false){
+    List.sort(key, reverse);
+    return List;
+}
+
+template<size_t Arity = 2, typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+void heapify(pyList<Type, Allocator, Policy, InlineBytes> & List, Compare less = Compare()){
+    pyHeap<Type, Compare, Arity>::make(pyHeap<Type, Compare, Arity>::data(List), List.len(), less);
+}
+
+template<size_t Arity = 2, typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+void heappush(pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & item, Compare less = Compare()){
+    List.append(item);
+    pyHeap<Type, Compare, Arity>::sift_up(pyHeap<Type, Compare, Arity>::data(List), 0, List.len() - 1, less);
+}
+
+template<size_t Arity = 2, typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+Type heappop(pyList<Type, Allocator, Policy, InlineBytes> & List, Compare less = Compare()){
+    Type last = List.pop();
+    if(List.len() == 0){
+        return last;
+    }
+    Type *heap = pyHeap<Type, Compare, Arity>::data(List);
+    std::swap(last, heap[0]);
+    pyHeap<Type, Compare, Arity>::sift_down(heap, List.len(), 0, less);
+    return last;
+}
+
+template<size_t Arity = 2, typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+Type heapreplace(pyList<Type, Allocator, Policy, InlineBytes> & List, Type item, Compare less = Compare()){
+    if(List.len() == 0){
+        throw std::invalid_argument("IndexError: index out of range");
+    }
+    Type *heap = pyHeap<Type, Compare, Arity>::data(List);
+    std::swap(item, heap[0]);
+    pyHeap<Type, Compare, Arity>::sift_down(heap, List.len(), 0, less);
+    return item;
+}
+
+template<size_t Arity = 2, typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+Type heappushpop(pyList<Type, Allocator, Policy, InlineBytes> & List, Type item, Compare less = Compare()){
+    if(List.len() == 0){
+        return item;
+    }
+    Type *heap = pyHeap<Type, Compare, Arity>::data(List);
+    if(less(heap[0], item)){
+        std::swap(item, heap[0]);
+        pyHeap<Type, Compare, Arity>::sift_down(heap, List.len(), 0, less);
+    }
+    return item;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+pyList<Type, Allocator, Policy, InlineBytes> nsmallest(const long n, const pyList<Type, Allocator, Policy, InlineBytes> & List, Compare less = Compare()){
+    pyList<Type, Allocator, Policy, InlineBytes> result(std::allocator_traits<Allocator>::select_on_container_copy_construction(List.get_allocator()));
+    long m = std::min(n, List.len());
+    if(m <= 0){
+        return result;
+    }
+    auto earlier = [&List, less](const long a, const long b){ return less(List[a], List[b]) || (!less(List[b], List[a]) && a < b); };
+    auto later = [&earlier](const long a, const long b){ return earlier(b, a); };
+    std::vector<long> heap(m);
+    for(long i=0; i<m; i++){
+        heap[i] = i;
+    }
+    pyHeap<long, decltype(later)>::make(heap.data(), m, later);
+    long total = List.len();
+    const Type *top = &List[heap[0]];
+    auto it = List.begin() + m;
+    for(long i=m; i<total; i++, ++it){
+        if(less(*it, *top)){
+            heap[0] = i;
+            pyHeap<long, decltype(later)>::sift_down(heap.data(), m, 0, later);
+            top = &List[heap[0]];
+        }
+    }
+    pyTimSort<long, decltype(earlier)>::sort(heap.data(), m, earlier);
+    result.reserve(m);
+    for(long i:heap){
+        result.append(List[i]);
+    }
+    return result;
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes, typename Compare = pyLess<Type>>
+pyList<Type, Allocator, Policy, InlineBytes> nlargest(const long n, const pyList<Type, Allocator, Policy, InlineBytes> & List, Compare less = Compare()){
+    auto greater = [less](const Type & a, const Type & b){ return less(b, a); };
+    return nsmallest(n, List, greater);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long bisect_left(const pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & key, const long lo = 0, const long hi = LONG_MAX){
+    if(lo < 0){
+        throw std::invalid_argument("lo must be non-negative");
+    }
+    long stop = std::min(hi, List.len());
+    if(stop <= lo){
+        return lo;
+    }
+    return std::lower_bound(List.begin() + lo, List.begin() + stop, key) - List.begin();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+long bisect_right(const pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & key, const long lo = 0, const long hi = LONG_MAX){
+    if(lo < 0){
+        throw std::invalid_argument("lo must be non-negative");
+    }
+    long stop = std::min(hi, List.len());
+    if(stop <= lo){
+        return lo;
+    }
+    return std::upper_bound(List.begin() + lo, List.begin() + stop, key) - List.begin();
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void insort_left(pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & key, const long lo = 0, const long hi = LONG_MAX){
+    List.insert(bisect_left(List, key, lo, hi), key);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void insort_right(pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & key, const long lo = 0, const long hi = LONG_MAX){
+    List.insert(bisect_right(List, key, lo, hi), key);
+}
+
+template<typename Type, typename Allocator, typename Policy, size_t InlineBytes>
+void insort(pyList<Type, Allocator, Policy, InlineBytes> & List, const Type & key, const long lo = 0, const long hi = LONG_MAX){
+    insort_right(List, key, lo, hi);
+}
+
+template<typename Type>
+class pyBList{
+    struct Node;
+    typedef std::shared_ptr<Node> Link;
+
+    struct Node{
+        long size;
+        int height;
+        Link left;
+        Link right;
+        std::vector<Type> items;
+    };
+
+    static constexpr long LEAF_BYTES = 2048;
+    static constexpr long LEAF_SIZE = LEAF_BYTES / (long)sizeof(Type) > 16 ? LEAF_BYTES / (long)sizeof(Type) : 16;
+
+    Link Root;
+
+    static long _size(const Link & t){ return t ? t->size : 0; }
+    static int _height(const Link & t){ return t ? t->height : 0; }
+    static Link _leaf(std::vector<Type> &&);
+    static Link _node(const Link &, const Link &);
+    static Link _join(const Link &, const Link &);
+    static Link _join_right(const Link &, const Link &);
+    static Link _join_left(const Link &, const Link &);
+    static std::pair<Link, Link> _split(const Link &, const long);
+    static void _own(Link &);
+    static void _rebalance(Link &);
+    template<typename... Args>
+    static void _emplace(Link &, const long, Args &&...);
+    static Type _pop(Link &, const long);
+    static Type & _at(Link &, const long);
+    static const Type & _get(const Link &, const long);
+    static void _locate(const Link &, const long, const Type * &, long &, long &);
+    static void _drain(Link &, const bool, pyList<Type> &);
+    template<typename Visit>
+    static bool _each_leaf(const Link &, Visit &);
+    static Link _build(std::vector<Link> &, const long, const long);
+    void _assign(pyList<Type> &);
+    long _clamp(const long, const long, const long) const;
+
+public:
+    class const_iterator{
+        const pyBList<Type> *list;
+        long index;
+        mutable const Type *leaf;
+        mutable long leaf_start;
+        mutable long leaf_size;
+
+        const Type & _fetch(const long position) const {
+            if(position < leaf_start || position >= leaf_start + leaf_size){
+                _locate(list->Root, position, leaf, leaf_start, leaf_size);
+            }
+            return leaf[position - leaf_start];
+        }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Type * pointer;
+        typedef const Type & reference;
+
+        const_iterator() : list(nullptr), index(0), leaf(nullptr), leaf_start(0), leaf_size(0){}
+        const_iterator(const pyBList<Type> * source, const long position) : list(source), index(position), leaf(nullptr), leaf_start(0), leaf_size(0){}
+        reference operator * () const { return _fetch(index); }
+        pointer operator -> () const { return &_fetch(index); }
+        reference operator [] (const difference_type n) const { return _fetch(index + n); }
+        const_iterator & operator ++ (){ ++index; return *this; }
+        const_iterator operator ++ (int){ const_iterator old = *this; ++index; return old; }
+        const_iterator & operator -- (){ --index; return *this; }
+        const_iterator operator -- (int){ const_iterator old = *this; --index; return old; }
+        const_iterator & operator += (const difference_type n){ index += n; return *this; }
+        const_iterator & operator -= (const difference_type n){ index -= n; return *this; }
+        const_iterator operator + (const difference_type n) const { const_iterator it = *this; it.index += n; return it; }
+        const_iterator operator - (const difference_type n) const { const_iterator it = *this; it.index -= n; return it; }
+        friend const_iterator operator + (const difference_type n, const const_iterator & it){ return it + n; }
+        difference_type operator - (const const_iterator & rhs) const { return index - rhs.index; }
+        bool operator == (const const_iterator & rhs) const { return index == rhs.index; }
+        bool operator != (const const_iterator & rhs) const { return index != rhs.index; }
+        bool operator < (const const_iterator & rhs) const { return index < rhs.index; }
+        bool operator > (const const_iterator & rhs) const { return index > rhs.index; }
+        bool operator <= (const const_iterator & rhs) const { return index <= rhs.index; }
+        bool operator >= (const const_iterator & rhs) const { return index >= rhs.index; }
+    };
+
+    pyBList();
+    pyBList(const pyBList<Type> &);
+    pyBList(pyBList<Type> &&) = default;
+    pyBList(const std::initializer_list<Type>);
+    pyBList<Type> & operator = (pyBList<Type>);
+    Type & operator [] (const long);
+    const Type & operator [] (const long) const;
+    pyBList<Type> operator () (const long = 0, const long = LONG_MAX, const long = 1) const;
+    pyBList<Type> operator + (const pyBList<Type> &) const;
+    void operator += (const pyBList<Type> &);
+    pyBList<Type> operator * (const long) const;
+    void operator *= (const long);
+    bool operator == (const pyBList<Type> &) const;
+    bool operator != (const pyBList<Type> &) const;
+    bool operator < (const pyBList<Type> &) const;
+    bool operator >= (const pyBList<Type> &) const;
+    bool operator <= (const pyBList<Type> &) const;
+    bool operator > (const pyBList<Type> &) const;
+    inline long len() const { return _size(Root); }
+    void reverse();
+    const Type & get(const long) const;
+    void set(const long, const Type &);
+    void set(const long, Type &&);
+    void append(const Type &);
+    void append(Type &&);
+    template<typename... Args>
+    Type & emplace_back(Args &&...);
+    void extend(const pyBList<Type> &);
+    pyBList<Type> slice(const long = 0, const long = LONG_MAX, const long = 1) const;
+    Type pop(const long = -1);
+    void remove(const Type &);
+    void clear();
+    long count(const Type &) const;
+    long index(const Type &, const long = 0, const long = LONG_MAX) const;
+    Type max() const;
+    Type min() const;
+    Type sum() const;
+    void insert(const long, const Type &);
+    void insert(const long, Type &&);
+    template<typename... Args>
+    Type & emplace(const long, Args &&...);
+    void sort(const bool = false);
+    template<typename Key>
+    void sort(Key, const bool = false);
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, len()); }
+};
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_leaf(std::vector<Type> && items){
+    Link t = std::make_shared<Node>();
+    t->items = std::move(items);
+    t->size = t->items.size();
+    t->height = 1;
+    return t;
+}
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_node(const Link & left, const Link & right){
+    Link t = std::make_shared<Node>();
+    t->size = left->size + right->size;
+    t->height = 1 + std::max(left->height, right->height);
+    t->left = left;
+    t->right = right;
+    return t;
+}
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_join(const Link & left, const Link & right){
+    if(!left){
+        return right;
+    }
+    if(!right){
+        return left;
+    }
+    if constexpr(std::is_copy_constructible<Type>::value){
+        if(left->height == 1 && right->height == 1 && left->size + right->size <= LEAF_SIZE / 2){
+            std::vector<Type> items;
+            items.reserve(left->size + right->size);
+            items.insert(items.end(), left->items.begin(), left->items.end());
+            items.insert(items.end(), right->items.begin(), right->items.end());
+            return _leaf(std::move(items));
+        }
+    }
+    if(left->height > right->height + 1){
+        return _join_right(left, right);
+    }
+    if(right->height > left->height + 1){
+        return _join_left(left, right);
+    }
+    return _node(left, right);
+}
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_join_right(const Link & left, const Link & right){
+    Link t = _join(left->right, right);
+    if(t->height <= left->left->height + 1){
+        return _node(left->left, t);
+    }
+    if(_height(t->left) <= _height(t->right)){
+        return _node(_node(left->left, t->left), t->right);
+    }
+    return _node(_node(left->left, t->left->left), _node(t->left->right, t->right));
+}
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_join_left(const Link & left, const Link & right){
+    Link t = _join(left, right->left);
+    if(t->height <= right->right->height + 1){
+        return _node(t, right->right);
+    }
+    if(_height(t->right) <= _height(t->left)){
+        return _node(t->left, _node(t->right, right->right));
+    }
+    return _node(_node(t->left, t->right->left), _node(t->right->right, right->right));
+}
+
+template<typename Type>
+std::pair<typename pyBList<Type>::Link, typename pyBList<Type>::Link> pyBList<Type>::_split(const Link & t, const long k){
+    if(k <= 0){
+        return std::make_pair(Link(), t);
+    }
+    if(k >= _size(t)){
+        return std::make_pair(t, Link());
+    }
+    if(t->height == 1){
+        return std::make_pair(_leaf(std::vector<Type>(t->items.begin(), t->items.begin() + k)),
+                              _leaf(std::vector<Type>(t->items.begin() + k, t->items.end())));
+    }
+    if(k <= t->left->size){
+        std::pair<Link, Link> parts = _split(t->left, k);
+        return std::make_pair(parts.first, _join(parts.second, t->right));
+    }
+    std::pair<Link, Link> parts = _split(t->right, k - t->left->size);
+    return std::make_pair(_join(t->left, parts.first), parts.second);
+}
+
+template<typename Type>
+void pyBList<Type>::_own(Link & t){
+    if constexpr(std::is_copy_constructible<Type>::value){
+        if(t.use_count() > 1){
+            t = std::make_shared<Node>(*t);
+        }
+    }
+}
+
+template<typename Type>
+void pyBList<Type>::_rebalance(Link & t){
+    int hl = t->left->height;
+    int hr = t->right->height;
+    if(hl - hr > 1 || hr - hl > 1){
+        t = _join(t->left, t->right);
+        return;
+    }
+    t->size = t->left->size + t->right->size;
+    t->height = 1 + std::max(hl, hr);
+}
+
+template<typename Type>
+template<typename... Args>
+void pyBList<Type>::_emplace(Link & t, const long index, Args &&... args){
+    _own(t);
+    if(t->height == 1){
+        t->items.emplace(t->items.begin() + index, std::forward<Args>(args)...);
+        ++t->size;
+        if(t->size > LEAF_SIZE){
+            long half = t->size / 2;
+            std::vector<Type> tail(std::make_move_iterator(t->items.begin() + half), std::make_move_iterator(t->items.end()));
+            t->items.erase(t->items.begin() + half, t->items.end());
+            t->size = half;
+            t = _node(t, _leaf(std::move(tail)));
+        }
+        return;
+    }
+    if(index <= t->left->size){
+        _emplace(t->left, index, std::forward<Args>(args)...);
+    }
+    else{
+        _emplace(t->right, index - t->left->size, std::forward<Args>(args)...);
+    }
+    _rebalance(t);
+}
+
+template<typename Type>
+Type pyBList<Type>::_pop(Link & t, const long index){
+    _own(t);
+    if(t->height == 1){
+        Type key = std::move(t->items[index]);
+        t->items.erase(t->items.begin() + index);
+        --t->size;
+        if(t->size == 0){
+            t.reset();
+        }
+        return key;
+    }
+    Type key = index < t->left->size ? _pop(t->left, index) : _pop(t->right, index - t->left->size);
+    if(!t->left || !t->right){
+        Link child = t->left ? t->left : t->right;
+        t = child;
+    }
+    else if(t->left->height == 1 && t->right->height == 1 && t->left->size + t->right->size <= LEAF_SIZE / 2){
+        _own(t->left);
+        Link right = t->right;
+        bool shared = false;
+        if constexpr(std::is_copy_constructible<Type>::value){
+            shared = right.use_count() > 2;
+        }
+        if(shared){
+            if constexpr(std::is_copy_constructible<Type>::value){
+                t->left->items.insert(t->left->items.end(), right->items.begin(), right->items.end());
+            }
+        }
+        else{
+            t->left->items.insert(t->left->items.end(), std::make_move_iterator(right->items.begin()), std::make_move_iterator(right->items.end()));
+        }
+        t->left->size += right->size;
+        Link child = t->left;
+        t = child;
+    }
+    else{
+        _rebalance(t);
+    }
+    return key;
+}
+
+template<typename Type>
+Type & pyBList<Type>::_at(Link & t, const long index){
+    _own(t);
+    if(t->height == 1){
+        return t->items[index];
+    }
+    if(index < t->left->size){
+        return _at(t->left, index);
+    }
+    return _at(t->right, index - t->left->size);
+}
+
+template<typename Type>
+const Type & pyBList<Type>::_get(const Link & t, const long index){
+    const Node *node = t.get();
+    long position = index;
+    while(node->height > 1){
+        if(position < node->left->size){
+            node = node->left.get();
+        }
+        else{
+            position -= node->left->size;
+            node = node->right.get();
+        }
+    }
+    return node->items[position];
+}
+
+template<typename Type>
+void pyBList<Type>::_locate(const Link & t, const long index, const Type * & leaf, long & start, long & size){
+    const Node *node = t.get();
+    start = 0;
+    while(node->height > 1){
+        if(index - start < node->left->size){
+            node = node->left.get();
+        }
+        else{
+            start += node->left->size;
+            node = node->right.get();
+        }
+    }
+    leaf = node->items.data();
+    size = node->size;
+}
+
+template<typename Type>
+template<typename Visit>
+bool pyBList<Type>::_each_leaf(const Link & t, Visit & visit){
+    if(!t){
+        return true;
+    }
+    if(t->height == 1){
+        return visit(t->items.data(), t->size);
+    }
+    return _each_leaf(t->left, visit) && _each_leaf(t->right, visit);
+}
+
+template<typename Type>
+void pyBList<Type>::_drain(Link & t, const bool unique, pyList<Type> & out){
+    if(!t){
+        return;
+    }
+    bool owned = unique && t.use_count() == 1;
+    if(t->height > 1){
+        _drain(t->left, owned, out);
+        _drain(t->right, owned, out);
+        return;
+    }
+    if constexpr(std::is_copy_constructible<Type>::value){
+        if(!owned){
+            for(const Type & item:t->items){
+                out.append(item);
+            }
+            return;
+        }
+    }
+    for(Type & item:t->items){
+        out.append(std::move(item));
+    }
+}
+
+template<typename Type>
+typename pyBList<Type>::Link pyBList<Type>::_build(std::vector<Link> & leaves, const long lo, const long hi){
+    if(hi - lo == 1){
+        return leaves[lo];
+    }
+    long mid = lo + (hi - lo) / 2;
+    return _node(_build(leaves, lo, mid), _build(leaves, mid, hi));
+}
+
+template<typename Type>
+void pyBList<Type>::_assign(pyList<Type> & source){
+    long n = source.len();
+    std::vector<Link> leaves;
+    long fill = LEAF_SIZE / 2;
+    for(long i=0; i<n; i+=fill){
+        long end = std::min(n, i + fill);
+        std::vector<Type> items;
+        items.reserve(end - i);
+        for(long j=i; j<end; j++){
+            items.push_back(std::move(source[j]));
+        }
+        leaves.push_back(_leaf(std::move(items)));
+    }
+    Root = leaves.empty() ? Link() : _build(leaves, 0, leaves.size());
+}
+
+template<typename Type>
+long pyBList<Type>::_clamp(const long value, const long min_value, const long max_value) const {
+    if(value < min_value){
+        return min_value;
+    }
+    else if(value > max_value){
+        return max_value;
+    }
+    return value;
+}
+
+template<typename Type>
+pyBList<Type>::pyBList(){}
+
+template<typename Type>
+pyBList<Type>::pyBList(const pyBList<Type> & rhs) : Root(rhs.Root){
+    static_assert(std::is_copy_constructible<Type>::value, "pyBList copies share nodes and need a copyable Type");
+}
+
+template<typename Type>
+pyBList<Type>::pyBList(const std::initializer_list<Type> source){
+    pyList<Type> items;
+    for(const Type & item:source){
+        items.append(item);
+    }
+    _assign(items);
+}
+
+template<typename Type>
+pyBList<Type> & pyBList<Type>::operator = (pyBList<Type> rhs){
+    Root.swap(rhs.Root);
+    return *this;
+}
+
+template<typename Type>
+Type & pyBList<Type>::operator [] (const long index){
+    return _at(Root, index >= 0 ? index : index + len());
+}
+
+template<typename Type>
+const Type & pyBList<Type>::operator [] (const long index) const {
+    return _get(Root, index >= 0 ? index : index + len());
+}
+
+template<typename Type>
+const Type & pyBList<Type>::get(const long index) const {
+    if(index < len() && index >= -len()){
+        return (*this)[index];
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type>
+void pyBList<Type>::set(const long index, const Type & key){
+    if(index < len() && index >= -len()){
+        (*this)[index] = key;
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type>
+void pyBList<Type>::set(const long index, Type && key){
+    if(index < len() && index >= -len()){
+        (*this)[index] = std::move(key);
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type>
+pyBList<Type> pyBList<Type>::operator () (const long start, const long stop, const long step) const {
+    long first;
+    long n = pySliceBounds(len(), start, stop, step, first);
+    pyBList<Type> result;
+    if(n == 0){
+        return result;
+    }
+    if(step == 1){
+        result.Root = _split(_split(Root, first + n).first, first).second;
+        return result;
+    }
+    pyList<Type> items;
+    const_iterator it = begin() + first;
+    for(long i=0; i<n; i++){
+        items.append(it[i * step]);
+    }
+    result._assign(items);
+    return result;
+}
+
+template<typename Type>
+pyBList<Type> pyBList<Type>::slice(const long start, const long stop, const long step) const {
+    return (*this)(start, stop, step);
+}
+
+template<typename Type>
+pyBList<Type> pyBList<Type>::operator + (const pyBList<Type> & rhs) const {
+    pyBList<Type> result;
+    result.Root = _join(Root, rhs.Root);
+    return result;
+}
+
+template<typename Type>
+void pyBList<Type>::operator += (const pyBList<Type> & rhs){
+    extend(rhs);
+}
+
+template<typename Type>
+void pyBList<Type>::extend(const pyBList<Type> & List){
+    Root = _join(Root, List.Root);
+}
+
+template<typename Type>
+pyBList<Type> pyBList<Type>::operator * (const long rhs) const {
+    pyBList<Type> result;
+    Link base = Root;
+    for(long k = rhs; k > 0; k >>= 1){
+        if(k & 1){
+            result.Root = _join(result.Root, base);
+        }
+        if(k > 1){
+            base = _join(base, base);
+        }
+    }
+    return result;
+}
+
+template<typename Type>
+void pyBList<Type>::operator *= (const long rhs){
+    *this = (*this) * rhs;
+}
+
+template<typename Type>
+bool pyBList<Type>::operator == (const pyBList<Type> & rhs) const {
+    if(len() != rhs.len()){ return false; }
+    if(Root == rhs.Root){ return true; }
+    return std::equal(begin(), end(), rhs.begin());
+}
+
+template<typename Type>
+bool pyBList<Type>::operator != (const pyBList<Type> & rhs) const {
+    return !((*this) == rhs);
+}
+
+template<typename Type>
+bool pyBList<Type>::operator < (const pyBList<Type> & rhs) const {
+    return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+}
+
+template<typename Type>
+bool pyBList<Type>::operator >= (const pyBList<Type> & rhs) const {
+    return !((*this) < rhs);
+}
+
+template<typename Type>
+bool pyBList<Type>::operator <= (const pyBList<Type> & rhs) const {
+    return !((*this) > rhs);
+}
+
+template<typename Type>
+bool pyBList<Type>::operator > (const pyBList<Type> & rhs) const {
+    return (rhs < (*this));
+}
+
+template<typename Type>
+void pyBList<Type>::reverse(){
+    pyList<Type> items;
+    items.reserve(len());
+    _drain(Root, true, items);
+    items.reverse();
+    _assign(items);
+}
+
+template<typename Type>
+void pyBList<Type>::append(const Type & key){
+    emplace_back(key);
+}
+
+template<typename Type>
+void pyBList<Type>::append(Type && key){
+    emplace_back(std::move(key));
+}
+
+template<typename Type>
+template<typename... Args>
+Type & pyBList<Type>::emplace_back(Args &&... args){
+    return emplace(len(), std::forward<Args>(args)...);
+}
+
+template<typename Type>
+void pyBList<Type>::insert(const long index, const Type & key){
+    emplace(index, key);
+}
+
+template<typename Type>
+void pyBList<Type>::insert(const long index, Type && key){
+    emplace(index, std::move(key));
+}
+
+template<typename Type>
+template<typename... Args>
+Type & pyBList<Type>::emplace(const long index, Args &&... args){
+    long n = len();
+    long position = _clamp(index, -n, n);
+    position = position >= 0 ? position : position + n;
+    if(!Root){
+        std::vector<Type> items;
+        items.emplace_back(std::forward<Args>(args)...);
+        Root = _leaf(std::move(items));
+    }
+    else{
+        _emplace(Root, position, std::forward<Args>(args)...);
+    }
+    return (*this)[position];
+}
+
+template<typename Type>
+Type pyBList<Type>::pop(const long index){
+    long n = len();
+    if(index < n && -index <= n){
+        return _pop(Root, index >= 0 ? index : index + n);
+    }
+    else{
+        throw std::invalid_argument("pop index out of range");
+    }
+}
+
+template<typename Type>
+void pyBList<Type>::remove(const Type & key){
+    pop(index(key));
+}
+
+template<typename Type>
+void pyBList<Type>::clear(){
+    Root.reset();
+}
+
+template<typename Type>
+long pyBList<Type>::count(const Type & key) const {
+    long ctr = 0;
+    auto visit = [&](const Type * first, const long n){
+        ctr += pyReduce<Type>::count(first, n, key);
+        return true;
+    };
+    _each_leaf(Root, visit);
+    return ctr;
+}
+
+template<typename Type>
+long pyBList<Type>::index(const Type & key, const long start, const long stop) const {
+    long n = len();
+    long stop_clamped = _clamp(stop, -n-1, n);
+    stop_clamped = stop_clamped >= 0 ? stop_clamped : stop_clamped + n;
+    long start_clamped = _clamp(start, -n, n);
+    start_clamped = start_clamped >= 0 ? start_clamped : start_clamped + n;
+    long offset = 0;
+    long found = -1;
+    auto visit = [&](const Type * first, const long size){
+        long lo = std::max(start_clamped - offset, 0L);
+        long hi = std::min(stop_clamped - offset, size);
+        if(lo < hi){
+            long k = pyReduce<Type>::find(first + lo, hi - lo, key);
+            if(k < hi - lo){
+                found = offset + lo + k;
+                return false;
+            }
+        }
+        offset += size;
+        return offset < stop_clamped;
+    };
+    _each_leaf(Root, visit);
+    if(found < 0){
+        throw std::invalid_argument("Value not in list");
+    }
+    return found;
+}
+
+template<typename Type>
+Type pyBList<Type>::max() const {
+    if(!Root){
+        throw std::domain_error("max of empty list");
+    }
+    Type maximum = (*this)[0];
+    auto visit = [&](const Type * first, const long n){
+        maximum = pyReduce<Type>::max(first, n, maximum);
+        return true;
+    };
+    _each_leaf(Root, visit);
+    return maximum;
+}
+
+template<typename Type>
+Type pyBList<Type>::min() const {
+    if(!Root){
+        throw std::domain_error("min of empty list");
+    }
+    Type minimum = (*this)[0];
+    auto visit = [&](const Type * first, const long n){
+        minimum = pyReduce<Type>::min(first, n, minimum);
+        return true;
+    };
+    _each_leaf(Root, visit);
+    return minimum;
+}
+
+template<typename Type>
+Type pyBList<Type>::sum() const {
+    Type total = 0;
+    auto visit = [&](const Type * first, const long n){
+        total = pyReduce<Type>::sum(first, n, total);
+        return true;
+    };
+    _each_leaf(Root, visit);
+    return total;
+}
+
+template<typename Type>
+void pyBList<Type>::sort(const bool reverse){
+    pyList<Type> items;
+    items.reserve(len());
+    _drain(Root, true, items);
+    items.sort(reverse);
+    _assign(items);
+}
+
+template<typename Type>
+template<typename Key>
+void pyBList<Type>::sort(Key key, const bool reverse){
+    pyList<Type> items;
+    items.reserve(len());
+    _drain(Root, true, items);
+    items.sort(key, reverse);
+    _assign(items);
+}
+
+template<typename Type>
+std::ostream & operator << (std::ostream & o, const pyBList<Type> & List){
+    o << "[";
+    int flag = 0;
+    for(const Type & item:List){
+        if(flag == 0){ o << item; ++flag; }
+        else{ o << ", " << item; }
+    }
+    return o << "]";
+}
+
+template<typename Type, bool SingleProducerConsumer = false>
+class pyConcurrentList{
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr int SPIN_LIMIT = 64;
+    static_assert(std::is_nothrow_move_constructible<Type>::value && std::is_nothrow_move_assignable<Type>::value, "pyConcurrentList requires a nothrow movable Type");
+
+    struct Slot{
+        alignas(Type) unsigned char storage[sizeof(Type)];
+    };
+
+    struct SequencedSlot : Slot{
+        std::atomic<size_t> sequence;
+    };
+
+    typedef typename std::conditional<SingleProducerConsumer, Slot, SequencedSlot>::type Cell;
+
+    Cell *Array;
+    size_t allocated;
+    size_t mask;
+    alignas(CACHE_LINE) std::atomic<size_t> Head;
+    size_t cached_tail;
+    alignas(CACHE_LINE) std::atomic<size_t> Tail;
+    size_t cached_head;
+
+    Type * _slot(const size_t position){ return reinterpret_cast<Type *>(Array[position & mask].storage); }
+    static void _backoff(int &);
+    template<typename... Args>
+    bool _push(Args &&...);
+    long _push_n(const Type *, const long);
+    bool _claim(size_t &);
+    void _release(const size_t);
+
+public:
+    explicit pyConcurrentList(const long);
+    pyConcurrentList(const pyConcurrentList &) = delete;
+    pyConcurrentList & operator = (const pyConcurrentList &) = delete;
+    ~pyConcurrentList();
+    bool try_append(const Type &);
+    bool try_append(Type &&);
+    template<typename... Args>
+    bool try_emplace_back(Args &&...);
+    void append(const Type &);
+    void append(Type &&);
+    bool try_pop(Type &);
+    Type pop();
+    long append_n(const Type *, const long);
+    long pop_n(Type *, const long);
+    long len() const;
+    long capacity() const;
+    bool empty() const;
+};
+
+template<typename Type, bool SingleProducerConsumer>
+pyConcurrentList<Type, SingleProducerConsumer>::pyConcurrentList(const long request_size){
+    if(request_size <= 0){
+        throw std::invalid_argument("capacity must be positive");
+    }
+    allocated = 2;
+    while(allocated < (size_t)request_size){
+        allocated <<= 1;
+    }
+    mask = allocated - 1;
+    Array = new Cell[allocated];
+    if constexpr(!SingleProducerConsumer){
+        for(size_t i=0; i<allocated; i++){
+            Array[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    Head.store(0, std::memory_order_relaxed);
+    Tail.store(0, std::memory_order_relaxed);
+    cached_tail = 0;
+    cached_head = 0;
+}
+
+template<typename Type, bool SingleProducerConsumer>
+pyConcurrentList<Type, SingleProducerConsumer>::~pyConcurrentList(){
+    if constexpr(!std::is_trivially_destructible<Type>::value){
+        size_t tail = Tail.load(std::memory_order_acquire);
+        for(size_t i = Head.load(std::memory_order_acquire); i != tail; i++){
+            _slot(i)->~Type();
+        }
+    }
+    delete[] Array;
+}
+
+template<typename Type, bool SingleProducerConsumer>
+void pyConcurrentList<Type, SingleProducerConsumer>::_backoff(int & spins){
+    if(spins < SPIN_LIMIT){
+        ++spins;
+    }
+    else{
+        std::this_thread::yield();
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+template<typename... Args>
+bool pyConcurrentList<Type, SingleProducerConsumer>::_push(Args &&... args){
+    if constexpr(SingleProducerConsumer){
+        size_t tail = Tail.load(std::memory_order_relaxed);
+        if(tail - cached_head == allocated){
+            cached_head = Head.load(std::memory_order_acquire);
+            if(tail - cached_head == allocated){
+                return false;
+            }
+        }
+        ::new (static_cast<void *>(_slot(tail))) Type(std::forward<Args>(args)...);
+        Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    else{
+        size_t position = Tail.load(std::memory_order_relaxed);
+        while(true){
+            Cell & cell = Array[position & mask];
+            long diff = (long)(cell.sequence.load(std::memory_order_acquire) - position);
+            if(diff == 0){
+                if(Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                    break;
+                }
+            }
+            else if(diff < 0){
+                return false;
+            }
+            else{
+                position = Tail.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void *>(_slot(position))) Type(std::forward<Args>(args)...);
+        Array[position & mask].sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+template<typename... Args>
+bool pyConcurrentList<Type, SingleProducerConsumer>::try_emplace_back(Args &&... args){
+    if constexpr(SingleProducerConsumer || std::is_nothrow_constructible<Type, Args &&...>::value){
+        return _push(std::forward<Args>(args)...);
+    }
+    else{
+        Type value(std::forward<Args>(args)...);
+        return _push(std::move(value));
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+bool pyConcurrentList<Type, SingleProducerConsumer>::try_append(const Type & key){
+    return try_emplace_back(key);
+}
+
+template<typename Type, bool SingleProducerConsumer>
+bool pyConcurrentList<Type, SingleProducerConsumer>::try_append(Type && key){
+    return try_emplace_back(std::move(key));
+}
+
+template<typename Type, bool SingleProducerConsumer>
+void pyConcurrentList<Type, SingleProducerConsumer>::append(const Type & key){
+    Type value(key);
+    append(std::move(value));
+}
+
+template<typename Type, bool SingleProducerConsumer>
+void pyConcurrentList<Type, SingleProducerConsumer>::append(Type && key){
+    int spins = 0;
+    while(!_push(std::move(key))){
+        _backoff(spins);
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+bool pyConcurrentList<Type, SingleProducerConsumer>::_claim(size_t & position){
+    if constexpr(SingleProducerConsumer){
+        position = Head.load(std::memory_order_relaxed);
+        if(position == cached_tail){
+            cached_tail = Tail.load(std::memory_order_acquire);
+            if(position == cached_tail){
+                return false;
+            }
+        }
+        return true;
+    }
+    else{
+        position = Head.load(std::memory_order_relaxed);
+        while(true){
+            Cell & cell = Array[position & mask];
+            long diff = (long)(cell.sequence.load(std::memory_order_acquire) - (position + 1));
+            if(diff == 0){
+                if(Head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                    return true;
+                }
+            }
+            else if(diff < 0){
+                return false;
+            }
+            else{
+                position = Head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+void pyConcurrentList<Type, SingleProducerConsumer>::_release(const size_t position){
+    _slot(position)->~Type();
+    if constexpr(SingleProducerConsumer){
+        Head.store(position + 1, std::memory_order_release);
+    }
+    else{
+        Array[position & mask].sequence.store(position + allocated, std::memory_order_release);
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+bool pyConcurrentList<Type, SingleProducerConsumer>::try_pop(Type & key){
+    size_t position;
+    if(!_claim(position)){
+        return false;
+    }
+    key = std::move(*_slot(position));
+    _release(position);
+    return true;
+}
+
+template<typename Type, bool SingleProducerConsumer>
+Type pyConcurrentList<Type, SingleProducerConsumer>::pop(){
+    size_t position;
+    int spins = 0;
+    while(!_claim(position)){
+        _backoff(spins);
+    }
+    Type key(std::move(*_slot(position)));
+    _release(position);
+    return key;
+}
+
+template<typename Type, bool SingleProducerConsumer>
+long pyConcurrentList<Type, SingleProducerConsumer>::_push_n(const Type * source, const long n){
+    if(n <= 0){
+        return 0;
+    }
+    if constexpr(SingleProducerConsumer){
+        size_t tail = Tail.load(std::memory_order_relaxed);
+        long space = allocated - (tail - cached_head);
+        if(space < n){
+            cached_head = Head.load(std::memory_order_acquire);
+            space = allocated - (tail - cached_head);
+        }
+        long k = n < space ? n : space;
+        if constexpr(std::is_trivially_copyable<Type>::value){
+            long first = allocated - (tail & mask);
+            first = first < k ? first : k;
+            std::memcpy(static_cast<void *>(_slot(tail)), static_cast<const void *>(source), first * sizeof(Type));
+            std::memcpy(static_cast<void *>(_slot(tail + first)), static_cast<const void *>(source + first), (k - first) * sizeof(Type));
+        }
+        else{
+            long i = 0;
+            try{
+                for(; i<k; i++){
+                    ::new (static_cast<void *>(_slot(tail + i))) Type(source[i]);
+                }
+            }
+            catch(...){
+                Tail.store(tail + i, std::memory_order_release);
+                throw;
+            }
+        }
+        Tail.store(tail + k, std::memory_order_release);
+        return k;
+    }
+    else{
+        size_t position = Tail.load(std::memory_order_relaxed);
+        long k;
+        while(true){
+            long used = (long)(position - Head.load(std::memory_order_acquire));
+            if(used < 0){
+                position = Tail.load(std::memory_order_relaxed);
+                continue;
+            }
+            k = (long)allocated - used;
+            k = n < k ? n : k;
+            if(k <= 0){
+                return 0;
+            }
+            if(Tail.compare_exchange_weak(position, position + k, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        for(long i=0; i<k; i++){
+            Cell & cell = Array[(position + i) & mask];
+            int spins = 0;
+            while(cell.sequence.load(std::memory_order_acquire) != position + i){
+                _backoff(spins);
+            }
+            ::new (static_cast<void *>(_slot(position + i))) Type(source[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+long pyConcurrentList<Type, SingleProducerConsumer>::append_n(const Type * items, const long n){
+    if constexpr(SingleProducerConsumer || std::is_nothrow_copy_constructible<Type>::value){
+        return _push_n(items, n);
+    }
+    else{
+        long i = 0;
+        while(i < n && try_append(items[i])){
+            ++i;
+        }
+        return i;
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+long pyConcurrentList<Type, SingleProducerConsumer>::pop_n(Type * items, const long n){
+    if(n <= 0){
+        return 0;
+    }
+    if constexpr(SingleProducerConsumer){
+        size_t head = Head.load(std::memory_order_relaxed);
+        long ready = cached_tail - head;
+        if(ready < n){
+            cached_tail = Tail.load(std::memory_order_acquire);
+            ready = cached_tail - head;
+        }
+        long k = n < ready ? n : ready;
+        if constexpr(std::is_trivially_copyable<Type>::value){
+            long first = allocated - (head & mask);
+            first = first < k ? first : k;
+            std::memcpy(static_cast<void *>(items), static_cast<const void *>(_slot(head)), first * sizeof(Type));
+            std::memcpy(static_cast<void *>(items + first), static_cast<const void *>(_slot(head + first)), (k - first) * sizeof(Type));
+        }
+        else{
+            for(long i=0; i<k; i++){
+                Type *slot = _slot(head + i);
+                items[i] = std::move(*slot);
+                slot->~Type();
+            }
+        }
+        Head.store(head + k, std::memory_order_release);
+        return k;
+    }
+    else{
+        size_t position = Head.load(std::memory_order_relaxed);
+        long k;
+        while(true){
+            long ready = (long)(Tail.load(std::memory_order_acquire) - position);
+            k = n < ready ? n : ready;
+            if(k <= 0){
+                return 0;
+            }
+            if(Head.compare_exchange_weak(position, position + k, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        for(long i=0; i<k; i++){
+            Cell & cell = Array[(position + i) & mask];
+            int spins = 0;
+            while(cell.sequence.load(std::memory_order_acquire) != position + i + 1){
+                _backoff(spins);
+            }
+            Type *slot = _slot(position + i);
+            items[i] = std::move(*slot);
+            slot->~Type();
+            cell.sequence.store(position + i + allocated, std::memory_order_release);
+        }
+        return k;
+    }
+}
+
+template<typename Type, bool SingleProducerConsumer>
+long pyConcurrentList<Type, SingleProducerConsumer>::len() const {
+    size_t head = Head.load(std::memory_order_acquire);
+    long n = (long)(Tail.load(std::memory_order_acquire) - head);
+    return n < 0 ? 0 : (n > (long)allocated ? (long)allocated : n);
+}
+
+template<typename Type, bool SingleProducerConsumer>
+long pyConcurrentList<Type, SingleProducerConsumer>::capacity() const {
+    return allocated;
+}
+
+template<typename Type, bool SingleProducerConsumer>
+bool pyConcurrentList<Type, SingleProducerConsumer>::empty() const {
+    return len() == 0;
+}
+
+template<typename Type, typename Hash = std::hash<Type>>
+class pyIndexedList{
+    static constexpr size_t REBUILD_THRESHOLD = 32;
+
+    struct Entry{
+        long count;
+        long ticket;
+        size_t epoch;
+        bool exact;
+    };
+
+    pyList<Type> items;
+    std::unordered_map<Type, Entry, Hash> table;
+    std::vector<std::pair<long, long>> pending;
+    long base;
+    bool stale;
+
+    void _resolve(Entry &);
+    long _first(const Type &, Entry &);
+    void _shift(const long, const long);
+    void _note(const Type &, const long);
+    void _forget(const Type &, const long);
+    void _rebuild();
+    void _recount();
+
+public:
+    pyIndexedList();
+    pyIndexedList(const std::initializer_list<Type>);
+    explicit pyIndexedList(const pyList<Type> &);
+    const Type & operator [] (const long index) const { return items[index]; }
+    const Type & get(const long index) const { return items.get(index); }
+    inline long len() const { return items.len(); }
+    const pyList<Type> & list() const { return items; }
+    typename pyList<Type>::const_iterator begin() const { return items.begin(); }
+    typename pyList<Type>::const_iterator end() const { return items.end(); }
+    void set(const long, const Type &);
+    void append(const Type &);
+    void extend(const pyList<Type> &);
+    void insert(const long, const Type &);
+    Type pop(const long = -1);
+    void remove(const Type &);
+    void clear();
+    bool contains(const Type &) const;
+    long count(const Type &) const;
+    long index(const Type &, const long = 0, const long = LONG_MAX);
+    void reverse();
+    void sort(const bool = false);
+    template<typename Key>
+    void sort(Key, const bool = false);
+};
+
+template<typename Type, typename Hash>
+pyIndexedList<Type, Hash>::pyIndexedList() : base(0), stale(false){
+}
+
+template<typename Type, typename Hash>
+pyIndexedList<Type, Hash>::pyIndexedList(const std::initializer_list<Type> source) : items(source), base(0), stale(true){
+    _recount();
+}
+
+template<typename Type, typename Hash>
+pyIndexedList<Type, Hash>::pyIndexedList(const pyList<Type> & source) : items(source), base(0), stale(true){
+    _recount();
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_recount(){
+    table.clear();
+    table.reserve(items.len());
+    for(const Type & item:items){
+        Entry & entry = table.emplace(item, Entry{0, 0, 0, false}).first->second;
+        ++entry.count;
+    }
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_rebuild(){
+    for(auto & slot:table){
+        slot.second.exact = false;
+        slot.second.epoch = 0;
+    }
+    pending.clear();
+    base = 0;
+    long position = 0;
+    for(const Type & item:items){
+        Entry & entry = table.find(item)->second;
+        if(!entry.exact){
+            entry.ticket = position;
+            entry.exact = true;
+        }
+        ++position;
+    }
+    stale = false;
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_resolve(Entry & entry){
+    for(size_t i = entry.epoch; i < pending.size(); i++){
+        if(pending[i].second > 0 ? entry.ticket >= pending[i].first : entry.ticket > pending[i].first){
+            entry.ticket += pending[i].second;
+        }
+    }
+    entry.epoch = pending.size();
+}
+
+template<typename Type, typename Hash>
+long pyIndexedList<Type, Hash>::_first(const Type & key, Entry & entry){
+    if(stale){
+        _rebuild();
+    }
+    _resolve(entry);
+    if(!entry.exact){
+        entry.ticket = base + items.index(key, std::max(entry.ticket - base, 0L));
+        entry.exact = true;
+    }
+    return entry.ticket - base;
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_shift(const long ticket, const long delta){
+    if(stale){
+        return;
+    }
+    if(pending.size() >= REBUILD_THRESHOLD){
+        stale = true;
+        return;
+    }
+    pending.emplace_back(ticket, delta);
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_note(const Type & key, const long ticket){
+    auto found = table.find(key);
+    if(found == table.end()){
+        table.emplace(key, Entry{1, ticket, pending.size(), true});
+        return;
+    }
+    Entry & entry = found->second;
+    ++entry.count;
+    if(stale){
+        return;
+    }
+    _resolve(entry);
+    if(ticket < entry.ticket){
+        entry.ticket = ticket;
+        entry.exact = true;
+    }
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::_forget(const Type & key, const long ticket){
+    auto found = table.find(key);
+    Entry & entry = found->second;
+    if(--entry.count == 0){
+        table.erase(found);
+        return;
+    }
+    if(stale){
+        return;
+    }
+    _resolve(entry);
+    if(entry.exact && entry.ticket == ticket){
+        entry.exact = false;
+    }
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::set(const long index, const Type & key){
+    const Type old = items.get(index);
+    if(old == key){
+        return;
+    }
+    long ticket = base + (index >= 0 ? index : index + items.len());
+    items.set(index, key);
+    _forget(old, ticket);
+    _note(key, ticket);
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::append(const Type & key){
+    long ticket = base + items.len();
+    items.append(key);
+    _note(key, ticket);
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::extend(const pyList<Type> & List){
+    if(&List == &items){
+        extend(pyList<Type>(List));
+        return;
+    }
+    items.reserve(items.len() + List.len());
+    for(const Type & item:List){
+        append(item);
+    }
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::insert(const long index, const Type & key){
+    long n = items.len();
+    long position = std::min(std::max(index, -n), n);
+    position = position >= 0 ? position : position + n;
+    if(position == n){
+        append(key);
+        return;
+    }
+    items.insert(position, key);
+    if(position == 0){
+        --base;
+    }
+    else{
+        _shift(base + position, 1);
+    }
+    _note(key, base + position);
+}
+
+template<typename Type, typename Hash>
+Type pyIndexedList<Type, Hash>::pop(const long index){
+    long n = items.len();
+    if(index >= n || index < -n){
+        throw std::invalid_argument("pop index out of range");
+    }
+    long position = index >= 0 ? index : index + n;
+    long ticket = base + position;
+    Type key = items.pop(position);
+    _forget(key, ticket);
+    if(position == 0){
+        ++base;
+    }
+    else if(position < n - 1){
+        _shift(ticket, -1);
+    }
+    return key;
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::remove(const Type & key){
+    auto found = table.find(key);
+    if(found == table.end()){
+        throw std::invalid_argument("Value not in list");
+    }
+    pop(_first(key, found->second));
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::clear(){
+    items.clear();
+    table.clear();
+    pending.clear();
+    base = 0;
+    stale = false;
+}
+
+template<typename Type, typename Hash>
+bool pyIndexedList<Type, Hash>::contains(const Type & key) const {
+    return table.find(key) != table.end();
+}
+
+template<typename Type, typename Hash>
+long pyIndexedList<Type, Hash>::count(const Type & key) const {
+    auto found = table.find(key);
+    return found == table.end() ? 0 : found->second.count;
+}
+
+template<typename Type, typename Hash>
+long pyIndexedList<Type, Hash>::index(const Type & key, const long start, const long stop){
+    auto found = table.find(key);
+    if(found == table.end()){
+        throw std::invalid_argument("Value not in list");
+    }
+    long n = items.len();
+    long first = _first(key, found->second);
+    long lo = start >= 0 ? start : std::max(start + n, 0L);
+    long hi = stop >= 0 ? std::min(stop, n) : stop + n;
+    if(first >= lo && first < hi){
+        return first;
+    }
+    return items.index(key, start, stop);
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::reverse(){
+    items.reverse();
+    stale = true;
+}
+
+template<typename Type, typename Hash>
+void pyIndexedList<Type, Hash>::sort(const bool reverse){
+    items.sort(reverse);
+    stale = true;
+}
+
+template<typename Type, typename Hash>
+template<typename Key>
+void pyIndexedList<Type, Hash>::sort(Key key, const bool reverse){
+    items.sort(key, reverse);
+    stale = true;
+}
+
+template<typename Type, typename Hash>
+std::ostream & operator << (std::ostream & o, const pyIndexedList<Type, Hash> & List){
+    return o << List.list();
+}
+
+template<typename Type, typename Compare = pyLess<Type>>
+class pySortedList{
+    static constexpr long LOAD = 1000;
+
+    std::vector<std::vector<Type>> chunks;
+    std::vector<Type> maxes;
+    std::vector<long> tree;
+    long length;
+    Compare less;
+
+    void _build_tree();
+    void _update_tree(const long, const long);
+    long _offset(const long) const;
+    void _locate(const long, long &, long &) const;
+    void _split(const long);
+    void _erase_at(const long, const long);
+    void _assign(std::vector<Type> &);
+
+public:
+    class const_iterator{
+        const pySortedList<Type, Compare> *list;
+        long chunk;
+        long offset;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Type * pointer;
+        typedef const Type & reference;
+
+        const_iterator() : list(nullptr), chunk(0), offset(0){}
+        const_iterator(const pySortedList<Type, Compare> * source, const long index, const long position) : list(source), chunk(index), offset(position){}
+        reference operator * () const { return list->chunks[chunk][offset]; }
+        pointer operator -> () const { return &list->chunks[chunk][offset]; }
+        const_iterator & operator ++ (){
+            if(++offset == (long)list->chunks[chunk].size()){
+                ++chunk;
+                offset = 0;
+            }
+            return *this;
+        }
+        const_iterator operator ++ (int){ const_iterator old = *this; ++*this; return old; }
+        const_iterator & operator -- (){
+            if(offset == 0){
+                --chunk;
+                offset = list->chunks[chunk].size();
+            }
+            --offset;
+            return *this;
+        }
+        const_iterator operator -- (int){ const_iterator old = *this; --*this; return old; }
+        bool operator == (const const_iterator & rhs) const { return chunk == rhs.chunk && offset == rhs.offset; }
+        bool operator != (const const_iterator & rhs) const { return !(*this == rhs); }
+    };
+
+    pySortedList();
+    pySortedList(const std::initializer_list<Type>);
+    const Type & operator [] (const long) const;
+    const Type & get(const long) const;
+    inline long len() const { return length; }
+    void add(const Type &);
+    template<typename Allocator, typename Policy, size_t InlineBytes>
+    void update(const pyList<Type, Allocator, Policy, InlineBytes> &);
+    void remove(const Type &);
+    bool discard(const Type &);
+    Type pop(const long = -1);
+    void clear();
+    bool contains(const Type &) const;
+    long count(const Type &) const;
+    long index(const Type &) const;
+    long bisect_left(const Type &) const;
+    long bisect_right(const Type &) const;
+    pyList<Type> islice(const long = 0, const long = LONG_MAX) const;
+    pyList<Type> irange(const Type &, const Type &, const bool = true, const bool = true) const;
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, chunks.size(), 0); }
+};
+
+template<typename Type, typename Compare>
+pySortedList<Type, Compare>::pySortedList() : length(0){
+}
+
+template<typename Type, typename Compare>
+pySortedList<Type, Compare>::pySortedList(const std::initializer_list<Type> source) : length(0){
+    std::vector<Type> values(source);
+    std::stable_sort(values.begin(), values.end(), less);
+    _assign(values);
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_build_tree(){
+    long m = chunks.size();
+    tree.assign(m + 1, 0);
+    for(long i=1; i<=m; i++){
+        tree[i] += chunks[i - 1].size();
+        long parent = i + (i & -i);
+        if(parent <= m){
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_update_tree(const long chunk, const long delta){
+    long m = chunks.size();
+    for(long i = chunk + 1; i <= m; i += i & -i){
+        tree[i] += delta;
+    }
+}
+
+template<typename Type, typename Compare>
+long pySortedList<Type, Compare>::_offset(const long chunk) const {
+    long total = 0;
+    for(long i = chunk; i > 0; i -= i & -i){
+        total += tree[i];
+    }
+    return total;
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_locate(const long index, long & chunk, long & offset) const {
+    long m = chunks.size();
+    long step = 1;
+    while(step * 2 <= m){
+        step *= 2;
+    }
+    chunk = 0;
+    offset = index;
+    for(; step > 0; step >>= 1){
+        if(chunk + step <= m && tree[chunk + step] <= offset){
+            chunk += step;
+            offset -= tree[chunk];
+        }
+    }
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_split(const long chunk){
+    std::vector<Type> & full = chunks[chunk];
+    std::vector<Type> half(std::make_move_iterator(full.begin() + LOAD), std::make_move_iterator(full.end()));
+    full.erase(full.begin() + LOAD, full.end());
+    maxes[chunk] = full.back();
+    maxes.insert(maxes.begin() + chunk + 1, half.back());
+    chunks.insert(chunks.begin() + chunk + 1, std::move(half));
+    _build_tree();
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_erase_at(const long chunk, const long offset){
+    std::vector<Type> & items = chunks[chunk];
+    items.erase(items.begin() + offset);
+    --length;
+    if(items.empty()){
+        chunks.erase(chunks.begin() + chunk);
+        maxes.erase(maxes.begin() + chunk);
+        _build_tree();
+        return;
+    }
+    maxes[chunk] = items.back();
+    if(chunks.size() > 1 && (long)items.size() < LOAD / 2){
+        long left = chunk > 0 ? chunk - 1 : chunk;
+        std::vector<Type> & merged = chunks[left];
+        merged.insert(merged.end(), std::make_move_iterator(chunks[left + 1].begin()), std::make_move_iterator(chunks[left + 1].end()));
+        maxes[left] = merged.back();
+        chunks.erase(chunks.begin() + left + 1);
+        maxes.erase(maxes.begin() + left + 1);
+        if((long)chunks[left].size() > 2 * LOAD){
+            _split(left);
+        }
+        else{
+            _build_tree();
+        }
+        return;
+    }
+    _update_tree(chunk, -1);
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::_assign(std::vector<Type> & values){
+    chunks.clear();
+    maxes.clear();
+    length = values.size();
+    for(long i=0; i<length; i+=LOAD){
+        long stop = std::min(i + LOAD, length);
+        chunks.emplace_back(std::make_move_iterator(values.begin() + i), std::make_move_iterator(values.begin() + stop));
+        maxes.push_back(chunks.back().back());
+    }
+    _build_tree();
+}
+
+template<typename Type, typename Compare>
+const Type & pySortedList<Type, Compare>::operator [] (const long index) const {
+    long chunk;
+    long offset;
+    _locate(index >= 0 ? index : index + length, chunk, offset);
+    return chunks[chunk][offset];
+}
+
+template<typename Type, typename Compare>
+const Type & pySortedList<Type, Compare>::get(const long index) const {
+    if(index < length && index >= -length){
+        return (*this)[index];
+    }
+    else{
+        throw std::invalid_argument("IndexError: list index out of range");
+    }
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::add(const Type & key){
+    if(chunks.empty()){
+        chunks.emplace_back(1, key);
+        maxes.push_back(key);
+        length = 1;
+        _build_tree();
+        return;
+    }
+    long chunk = std::upper_bound(maxes.begin(), maxes.end(), key, less) - maxes.begin();
+    if(chunk == (long)chunks.size()){
+        --chunk;
+        chunks[chunk].push_back(key);
+        maxes[chunk] = key;
+    }
+    else{
+        std::vector<Type> & items = chunks[chunk];
+        items.insert(std::upper_bound(items.begin(), items.end(), key, less), key);
+    }
+    ++length;
+    _update_tree(chunk, 1);
+    if((long)chunks[chunk].size() > 2 * LOAD){
+        _split(chunk);
+    }
+}
+
+template<typename Type, typename Compare>
+template<typename Allocator, typename Policy, size_t InlineBytes>
+void pySortedList<Type, Compare>::update(const pyList<Type, Allocator, Policy, InlineBytes> & List){
+    if(List.len() * 4 < length){
+        for(const Type & item:List){
+            add(item);
+        }
+        return;
+    }
+    std::vector<Type> values;
+    values.reserve(length + List.len());
+    for(std::vector<Type> & items:chunks){
+        std::move(items.begin(), items.end(), std::back_inserter(values));
+    }
+    long middle = values.size();
+    values.insert(values.end(), List.begin(), List.end());
+    std::stable_sort(values.begin() + middle, values.end(), less);
+    std::inplace_merge(values.begin(), values.begin() + middle, values.end(), less);
+    _assign(values);
+}
+
+template<typename Type, typename Compare>
+bool pySortedList<Type, Compare>::discard(const Type & key){
+    long chunk = std::lower_bound(maxes.begin(), maxes.end(), key, less) - maxes.begin();
+    if(chunk == (long)chunks.size()){
+        return false;
+    }
+    std::vector<Type> & items = chunks[chunk];
+    auto position = std::lower_bound(items.begin(), items.end(), key, less);
+    if(less(key, *position)){
+        return false;
+    }
+    _erase_at(chunk, position - items.begin());
+    return true;
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::remove(const Type & key){
+    if(!discard(key)){
+        throw std::invalid_argument("Value not in list");
+    }
+}
+
+template<typename Type, typename Compare>
+Type pySortedList<Type, Compare>::pop(const long index){
+    if(index >= length || index < -length){
+        throw std::invalid_argument("pop index out of range");
+    }
+    long chunk;
+    long offset;
+    _locate(index >= 0 ? index : index + length, chunk, offset);
+    Type key = std::move(chunks[chunk][offset]);
+    _erase_at(chunk, offset);
+    return key;
+}
+
+template<typename Type, typename Compare>
+void pySortedList<Type, Compare>::clear(){
+    chunks.clear();
+    maxes.clear();
+    tree.clear();
+    length = 0;
+}
+
+template<typename Type, typename Compare>
+long pySortedList<Type, Compare>::bisect_left(const Type & key) const {
+    long chunk = std::lower_bound(maxes.begin(), maxes.end(), key, less) - maxes.begin();
+    if(chunk == (long)chunks.size()){
+        return length;
+    }
+    const std::vector<Type> & items = chunks[chunk];
+    return _offset(chunk) + (std::lower_bound(items.begin(), items.end(), key, less) - items.begin());
+}
+
+template<typename Type, typename Compare>
+long pySortedList<Type, Compare>::bisect_right(const Type & key) const {
+    long chunk = std::upper_bound(maxes.begin(), maxes.end(), key, less) - maxes.begin();
+    if(chunk == (long)chunks.size()){
+        return length;
+    }
+    const std::vector<Type> & items = chunks[chunk];
+    return _offset(chunk) + (std::upper_bound(items.begin(), items.end(), key, less) - items.begin());
+}
+
+template<typename Type, typename Compare>
+bool pySortedList<Type, Compare>::contains(const Type & key) const {
+    long chunk = std::lower_bound(maxes.begin(), maxes.end(), key, less) - maxes.begin();
+    if(chunk == (long)chunks.size()){
+        return false;
+    }
+    const std::vector<Type> & items = chunks[chunk];
+    return !less(key, *std::lower_bound(items.begin(), items.end(), key, less));
+}
+
+template<typename Type, typename Compare>
+long pySortedList<Type, Compare>::count(const Type & key) const {
+    return bisect_right(key) - bisect_left(key);
+}
+
+template<typename Type, typename Compare>
+long pySortedList<Type, Compare>::index(const Type & key) const {
+    if(!contains(key)){
+        throw std::invalid_argument("Value not in list");
+    }
+    return bisect_left(key);
+}
+
+template<typename Type, typename Compare>
+pyList<Type> pySortedList<Type, Compare>::islice(const long start, const long stop) const {
+    long first;
+    long n = pySliceBounds(length, start, stop, 1, first);
+    pyList<Type> result;
+    if(n == 0){
+        return result;
+    }
+    result.reserve(n);
+    long chunk;
+    long offset;
+    _locate(first, chunk, offset);
+    while(n > 0){
+        const std::vector<Type> & items = chunks[chunk];
+        long run = std::min(n, (long)items.size() - offset);
+        for(long i=0; i<run; i++){
+            result.append(items[offset + i]);
+        }
+        n -= run;
+        ++chunk;
+        offset = 0;
+    }
+    return result;
+}
+
+template<typename Type, typename Compare>
+pyList<Type> pySortedList<Type, Compare>::irange(const Type & minimum, const Type & maximum, const bool inclusive_min, const bool inclusive_max) const {
+    long lo = inclusive_min ? bisect_left(minimum) : bisect_right(minimum);
+    long hi = inclusive_max ? bisect_right(maximum) : bisect_left(maximum);
+    if(hi <= lo){
+        return pyList<Type>();
+    }
+    return islice(lo, hi);
+}
+
+template<typename Type, typename Compare>
+std::ostream & operator << (std::ostream & o, const pySortedList<Type, Compare> & List){
+    o << "[";
+    int flag = 0;
+    for(const Type & item:List){
+        if(flag == 0){ o << item; ++flag; }
+        else{ o << ", " << item; }
+    }
+    return o << "]";
 }
 
 /*int main(){